@@ -29,7 +29,8 @@ public class AccelByteSocialToolkit : ModuleRules
 				"Json",
 				"JsonUtilities",
 				"Party",
-				"OnlineSubsystem", "OnlineSubsystemAccelByte"
+				"OnlineSubsystem", "OnlineSubsystemAccelByte",
+				"CommonUser"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
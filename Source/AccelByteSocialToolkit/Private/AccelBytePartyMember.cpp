@@ -5,7 +5,120 @@
 
 #include "AccelBytePartyMember.h"
 
+bool FAccelBytePartyMemberRepData::SetAttribute(FName Key, const FString& Value)
+{
+	if (!CanEditData())
+	{
+		LogSetPropertyFailure(TEXT("FAccelBytePartyMemberRepData"), *Key.ToString());
+		return false;
+	}
+
+	const FString* OldValue = Attributes.Find(Key);
+	if (OldValue != nullptr && *OldValue == Value)
+	{
+		return false;
+	}
+
+	Attributes.Add(Key, Value);
+	DirtyAttributes.Add(Key);
+	OnAttributeChangedEvent.Broadcast(Key, Value);
+	return true;
+}
+
+void FAccelBytePartyMemberRepData::PublishDirtyAttributes()
+{
+	if (DirtyAttributes.Num() > 0)
+	{
+		DirtyAttributes.Reset();
+		OnDataChanged.ExecuteIfBound();
+	}
+}
+
+void FAccelBytePartyMemberRepData::CompareAgainst(const FOnlinePartyRepDataBase& OldData) const
+{
+	FPartyMemberRepData::CompareAgainst(OldData);
+
+	const FAccelBytePartyMemberRepData& TypedOldData = static_cast<const FAccelBytePartyMemberRepData&>(OldData);
+
+	// Only notify for the attributes that actually changed in this update
+	for (const TPair<FName, FString>& Attribute : Attributes)
+	{
+		const FString* OldValue = TypedOldData.Attributes.Find(Attribute.Key);
+		if (OldValue == nullptr || *OldValue != Attribute.Value)
+		{
+			LogPropertyChanged(TEXT("FAccelBytePartyMemberRepData"), *Attribute.Key.ToString(), true);
+			OnAttributeChangedEvent.Broadcast(Attribute.Key, Attribute.Value);
+		}
+	}
+	for (const TPair<FName, FString>& OldAttribute : TypedOldData.Attributes)
+	{
+		if (!Attributes.Contains(OldAttribute.Key))
+		{
+			LogPropertyChanged(TEXT("FAccelBytePartyMemberRepData"), *OldAttribute.Key.ToString(), true);
+			OnAttributeChangedEvent.Broadcast(OldAttribute.Key, FString());
+		}
+	}
+}
+
 UAccelBytePartyMember::UAccelBytePartyMember()
 {
 	MemberDataReplicator.EstablishRepDataInstance<FAccelBytePartyMemberRepData>(RepData);
+
+	GConfig->GetFloat(TEXT("AccelByteSocialToolkit"), TEXT("MemberDataPublishInterval"), MemberDataPublishInterval, GEngineIni);
+}
+
+void UAccelBytePartyMember::BeginDestroy()
+{
+	if (PublishTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PublishTickerHandle);
+		PublishTickerHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
+
+bool UAccelBytePartyMember::SetMemberAttribute(FName Key, const FString& Value)
+{
+	if (!RepData.SetAttribute(Key, Value))
+	{
+		return false;
+	}
+
+	// Collect further changes until the publish interval has passed, then send them together
+	if (!PublishTickerHandle.IsValid())
+	{
+		const double Delay = FMath::Max(LastPublishTime + MemberDataPublishInterval - FPlatformTime::Seconds(), 0.0);
+		PublishTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UAccelBytePartyMember::HandlePublishTicker), static_cast<float>(Delay));
+	}
+	return true;
+}
+
+FString UAccelBytePartyMember::GetMemberAttribute(FName Key) const
+{
+	const FString* Value = RepData.FindAttribute(Key);
+	return Value ? *Value : FString();
+}
+
+void UAccelBytePartyMember::FlushMemberAttributes()
+{
+	if (PublishTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PublishTickerHandle);
+		PublishTickerHandle.Reset();
+	}
+
+	if (RepData.HasDirtyAttributes())
+	{
+		LastPublishTime = FPlatformTime::Seconds();
+		RepData.PublishDirtyAttributes();
+	}
+}
+
+bool UAccelBytePartyMember::HandlePublishTicker(float DeltaTime)
+{
+	PublishTickerHandle.Reset();
+	FlushMemberAttributes();
+	return false;
 }
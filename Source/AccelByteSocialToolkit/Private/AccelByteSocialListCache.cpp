@@ -0,0 +1,105 @@
+﻿// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+
+#include "AccelByteSocialListCache.h"
+
+#include "AccelByteSocialToolkitModule.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+bool FAccelByteSocialListCache::Load(const FString& InAccelByteId)
+{
+	*this = FAccelByteSocialListCache();
+	AccelByteId = InAccelByteId;
+
+	FString JsonString;
+	if (InAccelByteId.IsEmpty() || !FFileHelper::LoadFileToString(JsonString, *GetCacheFilePath(InAccelByteId)))
+	{
+		return false;
+	}
+
+	FAccelByteSocialListCache Loaded;
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &Loaded, 0, 0))
+	{
+		UE_LOG(LogAccelByteToolkit, Warning, TEXT("Social list cache for %s is corrupted, ignoring it"), *InAccelByteId);
+		return false;
+	}
+
+	if (Loaded.Version != CurrentVersion || Loaded.AccelByteId != InAccelByteId)
+	{
+		UE_LOG(LogAccelByteToolkit, Log, TEXT("Social list cache for %s is outdated (version %d), ignoring it"), *InAccelByteId, Loaded.Version);
+		return false;
+	}
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
+
+bool FAccelByteSocialListCache::Save() const
+{
+	if (AccelByteId.IsEmpty())
+	{
+		return false;
+	}
+
+	FString JsonString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(*this, JsonString, 0, 0))
+	{
+		return false;
+	}
+
+	return FFileHelper::SaveStringToFile(JsonString, *GetCacheFilePath(AccelByteId));
+}
+
+bool FAccelByteSocialListCache::Reconcile(TArray<FAccelByteCachedSocialUser>& CachedList, const TArray<FAccelByteCachedSocialUser>& BackendList, TArray<FString>& OutAddedIds, TArray<FString>& OutRemovedIds)
+{
+	bool bChanged = false;
+
+	TMap<FString, const FAccelByteCachedSocialUser*> BackendById;
+	BackendById.Reserve(BackendList.Num());
+	for (const FAccelByteCachedSocialUser& User : BackendList)
+	{
+		BackendById.Add(User.AccelByteId, &User);
+	}
+
+	// Drop users that are gone and refresh names of the ones that stayed
+	TSet<FString> CachedIds;
+	CachedIds.Reserve(CachedList.Num());
+	for (int32 Index = CachedList.Num() - 1; Index >= 0; --Index)
+	{
+		FAccelByteCachedSocialUser& Cached = CachedList[Index];
+		if (const FAccelByteCachedSocialUser* const* Backend = BackendById.Find(Cached.AccelByteId))
+		{
+			if (Cached.DisplayName != (*Backend)->DisplayName)
+			{
+				Cached.DisplayName = (*Backend)->DisplayName;
+				bChanged = true;
+			}
+			CachedIds.Add(Cached.AccelByteId);
+		}
+		else
+		{
+			OutRemovedIds.Add(Cached.AccelByteId);
+			CachedList.RemoveAtSwap(Index, 1, false);
+		}
+	}
+
+	for (const FAccelByteCachedSocialUser& User : BackendList)
+	{
+		if (!CachedIds.Contains(User.AccelByteId))
+		{
+			OutAddedIds.Add(User.AccelByteId);
+			CachedList.Add(User);
+		}
+	}
+
+	return bChanged || OutAddedIds.Num() > 0 || OutRemovedIds.Num() > 0;
+}
+
+FString FAccelByteSocialListCache::GetCacheFilePath(const FString& InAccelByteId)
+{
+	return FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("SocialCache") / (InAccelByteId + TEXT(".json"));
+}
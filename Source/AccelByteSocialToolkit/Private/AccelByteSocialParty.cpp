@@ -6,20 +6,170 @@
 #include "AccelByteSocialParty.h"
 
 #include "AccelBytePartyMember.h"
+#include "AccelByteSocialToolkitModule.h"
+#include "CommonSessionSubsystem.h"
+#include "Engine/GameInstance.h"
 
 
+bool FAccelBytePartyRepData::SetAttribute(FName Key, const FString& Value)
+{
+	if (!CanEditData())
+	{
+		LogSetPropertyFailure(TEXT("FAccelBytePartyRepData"), *Key.ToString());
+		return false;
+	}
+
+	const FString* OldValue = Attributes.Find(Key);
+	if (OldValue != nullptr && *OldValue == Value)
+	{
+		return false;
+	}
+
+	Attributes.Add(Key, Value);
+	OnAttributeChangedEvent.Broadcast(Key, Value);
+	OnDataChanged.ExecuteIfBound();
+	return true;
+}
+
+bool FAccelBytePartyRepData::RemoveAttribute(FName Key)
+{
+	if (!CanEditData() || Attributes.Remove(Key) == 0)
+	{
+		return false;
+	}
+
+	OnAttributeChangedEvent.Broadcast(Key, FString());
+	OnDataChanged.ExecuteIfBound();
+	return true;
+}
+
+bool FAccelBytePartyRepData::SetFastFollowSession(const FAccelBytePartyFastFollowSession& Session)
+{
+	if (!CanEditData())
+	{
+		LogSetPropertyFailure(TEXT("FAccelBytePartyRepData"), TEXT("FastFollowSession"));
+		return false;
+	}
+
+	if (FastFollowSession == Session)
+	{
+		return false;
+	}
+
+	FastFollowSession = Session;
+	OnFastFollowSessionChangedEvent.Broadcast(FastFollowSession);
+	OnDataChanged.ExecuteIfBound();
+	return true;
+}
+
 void FAccelBytePartyRepData::CompareAgainst(const FOnlinePartyRepDataBase& OldData) const
 {
 	FPartyRepData::CompareAgainst(OldData);
 	
 	const FAccelBytePartyRepData& TypedOldData = static_cast<const FAccelBytePartyRepData&>(OldData);
+
+	// Only notify for the attributes that actually changed in this update
+	for (const TPair<FName, FString>& Attribute : Attributes)
+	{
+		const FString* OldValue = TypedOldData.Attributes.Find(Attribute.Key);
+		if (OldValue == nullptr || *OldValue != Attribute.Value)
+		{
+			LogPropertyChanged(TEXT("FAccelBytePartyRepData"), *Attribute.Key.ToString(), true);
+			OnAttributeChangedEvent.Broadcast(Attribute.Key, Attribute.Value);
+		}
+	}
+	for (const TPair<FName, FString>& OldAttribute : TypedOldData.Attributes)
+	{
+		if (!Attributes.Contains(OldAttribute.Key))
+		{
+			LogPropertyChanged(TEXT("FAccelBytePartyRepData"), *OldAttribute.Key.ToString(), true);
+			OnAttributeChangedEvent.Broadcast(OldAttribute.Key, FString());
+		}
+	}
+
+	if (FastFollowSession != TypedOldData.FastFollowSession)
+	{
+		LogPropertyChanged(TEXT("FAccelBytePartyRepData"), TEXT("FastFollowSession"), true);
+		OnFastFollowSessionChangedEvent.Broadcast(FastFollowSession);
+	}
 }
 
 UAccelByteSocialParty::UAccelByteSocialParty() : Super()
 {
 	PartyDataReplicator.EstablishRepDataInstance<FAccelBytePartyRepData>(RepData);
+
+	GConfig->GetBool(TEXT("AccelByteSocialToolkit"), TEXT("bPartyFastFollow"), bPartyFastFollow, GEngineIni);
+	GConfig->GetFloat(TEXT("AccelByteSocialToolkit"), TEXT("FastFollowMaxAge"), FastFollowMaxAge, GEngineIni);
+}
+
+void UAccelByteSocialParty::InitializePartyInternal()
+{
+	Super::InitializePartyInternal();
+
+	if (!bPartyFastFollow)
+	{
+		return;
+	}
+
+	RepData.OnFastFollowSessionChanged().AddUObject(this, &UAccelByteSocialParty::HandleFastFollowSessionChanged);
+
+	const UGameInstance* GameInstance = GetTypedOuter<UGameInstance>();
+	if (UCommonSessionSubsystem* SessionSubsystem = GameInstance ? GameInstance->GetSubsystem<UCommonSessionSubsystem>() : nullptr)
+	{
+		SessionSubsystem->OnMatchmakingSessionChosenDelegate.AddUniqueDynamic(this, &UAccelByteSocialParty::HandleMatchmakingSessionChosen);
+	}
+}
+
+void UAccelByteSocialParty::HandleMatchmakingSessionChosen(const FString& SessionId, const FString& ConnectString)
+{
+	if (!IsPersistentParty() || !IsLocalPlayerPartyLeader() || GetNumPartyMembers() <= 1)
+	{
+		return;
+	}
+
+	FAccelBytePartyFastFollowSession Session;
+	Session.SessionId = SessionId;
+	Session.ConnectString = ConnectString;
+	Session.PublishedAt = FDateTime::UtcNow().ToUnixTimestamp();
+	RepData.SetFastFollowSession(Session);
 }
 
+void UAccelByteSocialParty::HandleFastFollowSessionChanged(const FAccelBytePartyFastFollowSession& Session)
+{
+	if (Session.SessionId.IsEmpty() || !IsPersistentParty() || IsLocalPlayerPartyLeader())
+	{
+		return;
+	}
+
+	const int64 Age = FDateTime::UtcNow().ToUnixTimestamp() - Session.PublishedAt;
+	if (Age > FastFollowMaxAge)
+	{
+		UE_LOG(LogAccelByteToolkit, Log, TEXT("Ignoring fast follow session %s published %lld seconds ago"), *Session.SessionId, Age);
+		return;
+	}
+
+	const UGameInstance* GameInstance = GetTypedOuter<UGameInstance>();
+	UCommonSessionSubsystem* SessionSubsystem = GameInstance ? GameInstance->GetSubsystem<UCommonSessionSubsystem>() : nullptr;
+	APlayerController* PlayerController = GameInstance ? GameInstance->GetFirstLocalPlayerController() : nullptr;
+	if (SessionSubsystem == nullptr || PlayerController == nullptr)
+	{
+		return;
+	}
+
+	UE_LOG(LogAccelByteToolkit, Log, TEXT("Following party leader into session %s"), *Session.SessionId);
+	SessionSubsystem->FastFollowSession(PlayerController, Session.SessionId, Session.ConnectString);
+}
+
+bool UAccelByteSocialParty::SetPartyAttribute(FName Key, const FString& Value)
+{
+	return RepData.SetAttribute(Key, Value);
+}
+
+FString UAccelByteSocialParty::GetPartyAttribute(FName Key) const
+{
+	const FString* Value = RepData.FindAttribute(Key);
+	return Value ? *Value : FString();
+}
 
 FPartyPrivacySettings UAccelByteSocialParty::GetDesiredPrivacySettings() const
 {
@@ -7,9 +7,19 @@
 
 #include "AccelByteSocialManager.h"
 #include "AccelByteSocialToolkitModule.h"
+#include "CommonSessionSubsystem.h"
 #include "OnlineSubsystemAccelByte.h"
+#include "OnlineSubsystemAccelByteTypes.h"
 #include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlinePartyInterfaceAccelByte.h"
+#include "Interfaces/OnlineFriendsInterface.h"
+#include "Interfaces/OnlinePresenceInterface.h"
+#include "User/SocialUser.h"
+#include "Party/SocialParty.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
 
 void UAccelByteSocialToolkit::InitializeToolkit(ULocalPlayer& InOwningLocalPlayer)
 {
@@ -18,6 +28,40 @@ void UAccelByteSocialToolkit::InitializeToolkit(ULocalPlayer& InOwningLocalPlaye
 	bQueryFriendsOnStartup = false;
 	bQueryBlockedPlayersOnStartup = false;
 	bQueryRecentPlayersOnStartup = false;
+
+	GConfig->GetInt(TEXT("AccelByteSocialToolkit"), TEXT("MaxConcurrentSocialQueries"), MaxConcurrentSocialQueries, GEngineIni);
+	GConfig->GetFloat(TEXT("AccelByteSocialToolkit"), TEXT("RecentPlayersQueryDelay"), RecentPlayersQueryDelay, GEngineIni);
+	GConfig->GetFloat(TEXT("AccelByteSocialToolkit"), TEXT("SocialQueryTimeout"), SocialQueryTimeout, GEngineIni);
+	GConfig->GetFloat(TEXT("AccelByteSocialToolkit"), TEXT("RecentPlayersCacheMaxAge"), RecentPlayersCacheMaxAge, GEngineIni);
+	GConfig->GetBool(TEXT("AccelByteSocialToolkit"), TEXT("bLazyCreateParty"), bLazyCreateParty, GEngineIni);
+	GConfig->GetString(TEXT("AccelByteSocialToolkit"), TEXT("LogoutMap"), LogoutMap, GEngineIni);
+	GConfig->GetBool(TEXT("AccelByteSocialToolkit"), TEXT("bPreloadLogoutMap"), bPreloadLogoutMap, GEngineIni);
+	if (bPreloadLogoutMap)
+	{
+		PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UAccelByteSocialToolkit::HandlePostLoadMapWithWorld);
+	}
+	MaxConcurrentSocialQueries = FMath::Max(MaxConcurrentSocialQueries, 1);
+
+	// Party matchmaking goes through EnsurePersistentParty so it shares the creation with invites
+	const UGameInstance* GameInstance = InOwningLocalPlayer.GetGameInstance();
+	UCommonSessionSubsystem* SessionSubsystem = GameInstance ? GameInstance->GetSubsystem<UCommonSessionSubsystem>() : nullptr;
+	if (bLazyCreateParty && SessionSubsystem && !SessionSubsystem->EnsureMatchmakingPartyDelegate.IsBound())
+	{
+		SessionSubsystem->EnsureMatchmakingPartyDelegate.BindWeakLambda(this, [this](ULocalPlayer* LocalPlayer, const UCommonSessionSubsystem::FOnMatchmakingPartyReady& OnReady)
+		{
+			if (LocalPlayer != &GetOwningLocalPlayer() || GetSocialManager().GetPersistentParty() != nullptr)
+			{
+				return false;
+			}
+
+			EnsurePersistentParty(FOnPersistentPartyReady::CreateLambda([OnReady](USocialParty* Party)
+			{
+				OnReady.ExecuteIfBound(Party != nullptr);
+			}));
+			return true;
+		});
+		MatchmakingSessionSubsystem = SessionSubsystem;
+	}
 	
 	IOnlineSubsystem* Subsystem = GetSocialOss(ESocialSubsystem::Primary);
 	check(Subsystem);
@@ -27,15 +71,96 @@ void UAccelByteSocialToolkit::InitializeToolkit(ULocalPlayer& InOwningLocalPlaye
 		IdentityAccelByte->AddOnConnectLobbyCompleteDelegate_Handle(InOwningLocalPlayer.GetLocalPlayerIndex(),
 			FOnConnectLobbyCompleteDelegate::CreateUObject(this, &UAccelByteSocialToolkit::OnLobbyConnected));
 	}
+
+	// Completion of the base toolkit queries is only visible through the friends interface notifications
+	IOnlineFriendsPtr FriendsInterface = Subsystem->GetFriendsInterface();
+	if(FriendsInterface.IsValid())
+	{
+		BoundFriendsInterface = FriendsInterface;
+		QueryBlockedPlayersCompleteHandle = FriendsInterface->AddOnQueryBlockedPlayersCompleteDelegate_Handle(
+			FOnQueryBlockedPlayersCompleteDelegate::CreateUObject(this, &UAccelByteSocialToolkit::HandleQueryBlockedPlayersComplete));
+		QueryRecentPlayersCompleteHandle = FriendsInterface->AddOnQueryRecentPlayersCompleteDelegate_Handle(
+			FOnQueryRecentPlayersCompleteDelegate::CreateUObject(this, &UAccelByteSocialToolkit::HandleQueryRecentPlayersComplete));
+		FriendRemovedHandle = FriendsInterface->AddOnFriendRemovedDelegate_Handle(
+			FOnFriendRemovedDelegate::CreateUObject(this, &UAccelByteSocialToolkit::HandleFriendRemoved));
+		FriendInviteAcceptedHandle = FriendsInterface->AddOnInviteAcceptedDelegate_Handle(
+			FOnInviteAcceptedDelegate::CreateUObject(this, &UAccelByteSocialToolkit::HandleFriendInviteAccepted));
+	}
+
+	IOnlinePresencePtr PresenceInterface = Subsystem->GetPresenceInterface();
+	if(PresenceInterface.IsValid())
+	{
+		BoundPresenceInterface = PresenceInterface;
+		PresenceReceivedHandle = PresenceInterface->AddOnPresenceReceivedDelegate_Handle(
+			FOnPresenceReceivedDelegate::CreateUObject(this, &UAccelByteSocialToolkit::HandlePresenceReceived));
+	}
+
+	IOnlinePartyPtr PartyInterface = Subsystem->GetPartyInterface();
+	if(PartyInterface.IsValid())
+	{
+		BoundPartyInterface = PartyInterface;
+		PartyInviteReceivedExHandle = PartyInterface->AddOnPartyInviteReceivedExDelegate_Handle(
+			FOnPartyInviteReceivedExDelegate::CreateUObject(this, &UAccelByteSocialToolkit::HandlePartyInviteReceivedEx));
+	}
+}
+
+void UAccelByteSocialToolkit::BeginDestroy()
+{
+	ResetSocialQueries();
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	// The online interfaces are shared by every toolkit and outlive this one
+	if (IOnlineFriendsPtr FriendsInterface = BoundFriendsInterface.Pin())
+	{
+		FriendsInterface->ClearOnQueryBlockedPlayersCompleteDelegate_Handle(QueryBlockedPlayersCompleteHandle);
+		FriendsInterface->ClearOnQueryRecentPlayersCompleteDelegate_Handle(QueryRecentPlayersCompleteHandle);
+		FriendsInterface->ClearOnFriendRemovedDelegate_Handle(FriendRemovedHandle);
+		FriendsInterface->ClearOnInviteAcceptedDelegate_Handle(FriendInviteAcceptedHandle);
+	}
+	if (IOnlinePresencePtr PresenceInterface = BoundPresenceInterface.Pin())
+	{
+		PresenceInterface->ClearOnPresenceReceivedDelegate_Handle(PresenceReceivedHandle);
+	}
+	if (IOnlinePartyPtr PartyInterface = BoundPartyInterface.Pin())
+	{
+		PartyInterface->ClearOnPartyInviteReceivedExDelegate_Handle(PartyInviteReceivedExHandle);
+	}
+	if (UCommonSessionSubsystem* SessionSubsystem = MatchmakingSessionSubsystem.Get())
+	{
+		SessionSubsystem->EnsureMatchmakingPartyDelegate.Unbind();
+	}
+
+	Super::BeginDestroy();
 }
 
 UAccelByteSocialToolkit::UAccelByteSocialToolkit() : Super()
 {
 }
 
+bool UAccelByteSocialToolkit::IsSocialQueryReady(EAccelByteSocialQuery Query) const
+{
+	return ReadySocialQueries.Contains(Query);
+}
+
 void UAccelByteSocialToolkit::OnCreatePartyComplete(ECreatePartyCompletionResult CreatePartyCompletionResult)
 {
-	UE_LOG(LogAccelByteToolkit, Log, TEXT("Party Creation Succeed!"));
+	bPartyCreationInFlight = false;
+
+	USocialParty* Party = GetSocialManager().GetPersistentParty();
+	if (CreatePartyCompletionResult == ECreatePartyCompletionResult::Succeeded)
+	{
+		UE_LOG(LogAccelByteToolkit, Log, TEXT("Party Creation Succeed!"));
+	}
+	else
+	{
+		UE_LOG(LogAccelByteToolkit, Warning, TEXT("Party Creation Failed! (%s)"), ToString(CreatePartyCompletionResult));
+	}
+
+	TArray<FOnPersistentPartyReady> Actions = MoveTemp(PendingPartyActions);
+	for (const FOnPersistentPartyReady& Action : Actions)
+	{
+		Action.ExecuteIfBound(Party);
+	}
 }
 
 void UAccelByteSocialToolkit::OnLobbyConnected(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId,
@@ -43,36 +168,528 @@ void UAccelByteSocialToolkit::OnLobbyConnected(int32 LocalUserNum, bool bWasSucc
 {
 	if (IsOwnerLoggedIn())
 	{
-		QueryFriendsLists();
-		QueryBlockedPlayers();
-		QueryRecentPlayers();
+		ResetSocialQueries();
 
-		bool bAutoCreateParty = false;
-		GConfig->GetBool(TEXT("AccelByteSocialToolkit"), TEXT("bAutoCreateParty"), bAutoCreateParty, GEngineIni);
-		if(bAutoCreateParty)
+		// Show what we knew last time right away, the queries below only reconcile it
+		SocialListCache.Load(FUniqueNetIdAccelByteUser::Cast(UserId)->GetAccelByteId());
+		if (SocialListCache.RecentPlayersUpdateTime + FTimespan::FromSeconds(RecentPlayersCacheMaxAge) < FDateTime::UtcNow())
 		{
-			FPartyConfiguration Config;
-			Config.bIsAcceptingMembers = true;
-
-			int32 MaxPartyMembers = 0;
-			GConfig->GetInt(TEXT("AccelByteSocialToolkit"), TEXT("MaxPartyMembers"), MaxPartyMembers, GEngineIni);
-			Config.MaxMembers = MaxPartyMembers;
-
-			GetSocialManager().CreateParty(
-				FOnlinePartySystemAccelByte::GetAccelBytePartyTypeId(),
-				Config,
-				USocialManager::FOnCreatePartyAttemptComplete::CreateUObject(this, &ThisClass::OnCreatePartyComplete)
-			);
+			SocialListCache.RecentPlayers.Reset();
 		}
+		RebuildSocialUserIndex();
+		OnSocialListCacheLoadedDelegate.Broadcast();
+
+		// Blocked players first so filtering is available early, recent players only once things are quiet
+		ScheduleSocialQuery(EAccelByteSocialQuery::BlockedPlayers);
+		ScheduleSocialQuery(EAccelByteSocialQuery::Friends);
+		// The cache only feeds the user index, the toolkit's own recent players list still needs the query
+		ScheduleSocialQuery(EAccelByteSocialQuery::RecentPlayers);
+
+		// In lazy mode the party is created by the first invite or party matchmaking request instead
+		bool bAutoCreateParty = false;
+		GConfig->GetBool(TEXT("AccelByteSocialToolkit"), TEXT("bAutoCreateParty"), bAutoCreateParty, GEngineIni);
+		bCreatePartyWhenReady = bAutoCreateParty && !bLazyCreateParty;
+
+		PumpSocialQueries();
 	}
 	
 	OnLobbyConnectedDelegate.Broadcast();
 }
 
+void UAccelByteSocialToolkit::CreateDefaultParty()
+{
+	FPartyConfiguration Config;
+	Config.bIsAcceptingMembers = true;
+
+	int32 MaxPartyMembers = 0;
+	GConfig->GetInt(TEXT("AccelByteSocialToolkit"), TEXT("MaxPartyMembers"), MaxPartyMembers, GEngineIni);
+	Config.MaxMembers = MaxPartyMembers;
+
+	bPartyCreationInFlight = true;
+	GetSocialManager().CreateParty(
+		FOnlinePartySystemAccelByte::GetAccelBytePartyTypeId(),
+		Config,
+		USocialManager::FOnCreatePartyAttemptComplete::CreateUObject(this, &ThisClass::OnCreatePartyComplete)
+	);
+}
+
+void UAccelByteSocialToolkit::EnsurePersistentParty(const FOnPersistentPartyReady& OnReady)
+{
+	if (USocialParty* Party = GetSocialManager().GetPersistentParty())
+	{
+		OnReady.ExecuteIfBound(Party);
+		return;
+	}
+
+	PendingPartyActions.Add(OnReady);
+
+	// A creation that is already running, or waiting for the social lists on login, will flush the action
+	if (!bPartyCreationInFlight && !bCreatePartyWhenReady)
+	{
+		UE_LOG(LogAccelByteToolkit, Log, TEXT("Creating the default party on first use"));
+		CreateDefaultParty();
+	}
+}
+
+bool UAccelByteSocialToolkit::InviteToPersistentParty(const FString& AccelByteId)
+{
+	USocialUser* User = FindSocialUserByAccelByteId(AccelByteId);
+	if (User == nullptr)
+	{
+		UE_LOG(LogAccelByteToolkit, Warning, TEXT("Cannot invite %s to the party, the user is unknown"), *AccelByteId);
+		return false;
+	}
+
+	TWeakObjectPtr<USocialUser> WeakUser(User);
+	EnsurePersistentParty(FOnPersistentPartyReady::CreateWeakLambda(this, [WeakUser](USocialParty* Party)
+	{
+		if (Party != nullptr && WeakUser.IsValid())
+		{
+			WeakUser->InviteToParty(Party->GetPartyTypeId());
+		}
+	}));
+	return true;
+}
+
+void UAccelByteSocialToolkit::ScheduleSocialQuery(EAccelByteSocialQuery Query)
+{
+	if (PendingSocialQueries.Contains(Query) || InFlightSocialQueries.Contains(Query))
+	{
+		return;
+	}
+
+	// Enum order is priority order
+	const int32 InsertIndex = Algo::UpperBound(PendingSocialQueries, Query);
+	PendingSocialQueries.Insert(Query, InsertIndex);
+
+	if (!SocialQueryTickerHandle.IsValid())
+	{
+		SocialQueryTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickSocialQueries), 0.25f);
+	}
+}
+
+void UAccelByteSocialToolkit::PumpSocialQueries()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	while (PendingSocialQueries.Num() > 0 && InFlightSocialQueries.Num() < MaxConcurrentSocialQueries)
+	{
+		const EAccelByteSocialQuery Query = PendingSocialQueries[0];
+		if (Query == EAccelByteSocialQuery::RecentPlayers
+			&& (InFlightSocialQueries.Num() > 0 || Now < LastSocialQueryCompleteTime + RecentPlayersQueryDelay))
+		{
+			// Recent players are not urgent, the ticker will try again once the toolkit is idle
+			break;
+		}
+
+		PendingSocialQueries.RemoveAt(0);
+		StartSocialQuery(Query);
+	}
+}
+
+void UAccelByteSocialToolkit::StartSocialQuery(EAccelByteSocialQuery Query)
+{
+	UE_LOG(LogAccelByteToolkit, Log, TEXT("Starting social query %s"), *UEnum::GetValueAsString(Query));
+	InFlightSocialQueries.Add(Query, FPlatformTime::Seconds());
+
+	switch (Query)
+	{
+	case EAccelByteSocialQuery::BlockedPlayers:
+		QueryBlockedPlayers();
+		break;
+	case EAccelByteSocialQuery::Friends:
+	{
+		QueryFriendsLists();
+
+		// The base toolkit read reports its result to the base class only, a read of our own tells when the list is in
+		IOnlineSubsystem* Subsystem = GetSocialOss(ESocialSubsystem::Primary);
+		IOnlineFriendsPtr FriendsInterface = Subsystem ? Subsystem->GetFriendsInterface() : nullptr;
+		if (!FriendsInterface.IsValid() || !FriendsInterface->ReadFriendsList(GetLocalUserNum(), EFriendsLists::ToString(EFriendsLists::Default),
+			FOnReadFriendsListComplete::CreateUObject(this, &UAccelByteSocialToolkit::HandleReadFriendsListComplete)))
+		{
+			CompleteSocialQuery(Query, false);
+		}
+		break;
+	}
+	case EAccelByteSocialQuery::RecentPlayers:
+		QueryRecentPlayers();
+		break;
+	}
+}
+
+void UAccelByteSocialToolkit::CompleteSocialQuery(EAccelByteSocialQuery Query, bool bWasSuccessful)
+{
+	if (InFlightSocialQueries.Remove(Query) == 0)
+	{
+		// Not one of ours, or it already timed out
+		return;
+	}
+
+	UE_LOG(LogAccelByteToolkit, Log, TEXT("Social query %s finished (bWasSuccessful: %s)"), *UEnum::GetValueAsString(Query), bWasSuccessful ? TEXT("true") : TEXT("false"));
+	LastSocialQueryCompleteTime = FPlatformTime::Seconds();
+	ReadySocialQueries.Add(Query);
+	if (bWasSuccessful)
+	{
+		ReconcileSocialListCache(Query);
+	}
+	OnSocialQueryReadyDelegate.Broadcast(Query, bWasSuccessful);
+
+	if (bCreatePartyWhenReady && IsSocialQueryReady(EAccelByteSocialQuery::BlockedPlayers) && IsSocialQueryReady(EAccelByteSocialQuery::Friends))
+	{
+		bCreatePartyWhenReady = false;
+		CreateDefaultParty();
+	}
+
+	PumpSocialQueries();
+}
+
+void UAccelByteSocialToolkit::ResetSocialQueries()
+{
+	PendingSocialQueries.Reset();
+	InFlightSocialQueries.Reset();
+	ReadySocialQueries.Reset();
+	bCreatePartyWhenReady = false;
+
+	if (SocialQueryTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SocialQueryTickerHandle);
+		SocialQueryTickerHandle.Reset();
+	}
+}
+
+bool UAccelByteSocialToolkit::TickSocialQueries(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<EAccelByteSocialQuery> TimedOutQueries;
+	for (const TPair<EAccelByteSocialQuery, double>& InFlight : InFlightSocialQueries)
+	{
+		if (Now - InFlight.Value > SocialQueryTimeout)
+		{
+			TimedOutQueries.Add(InFlight.Key);
+		}
+	}
+
+	for (const EAccelByteSocialQuery Query : TimedOutQueries)
+	{
+		UE_LOG(LogAccelByteToolkit, Warning, TEXT("Social query %s did not report completion in time"), *UEnum::GetValueAsString(Query));
+		CompleteSocialQuery(Query, false);
+	}
+
+	PumpSocialQueries();
+
+	if (PendingSocialQueries.Num() == 0 && InFlightSocialQueries.Num() == 0)
+	{
+		SocialQueryTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+bool UAccelByteSocialToolkit::IsOwningUser(const FUniqueNetId& UserId) const
+{
+	const FUniqueNetIdRepl LocalUserId = GetLocalUserNetId(ESocialSubsystem::Primary);
+	return LocalUserId.IsValid() && *LocalUserId == UserId;
+}
+
+void UAccelByteSocialToolkit::HandleQueryBlockedPlayersComplete(const FUniqueNetId& UserId, bool bWasSuccessful, const FString& Error)
+{
+	if (IsOwningUser(UserId))
+	{
+		CompleteSocialQuery(EAccelByteSocialQuery::BlockedPlayers, bWasSuccessful);
+	}
+}
+
+void UAccelByteSocialToolkit::HandleQueryRecentPlayersComplete(const FUniqueNetId& UserId, const FString& Namespace, bool bWasSuccessful, const FString& Error)
+{
+	if (IsOwningUser(UserId))
+	{
+		CompleteSocialQuery(EAccelByteSocialQuery::RecentPlayers, bWasSuccessful);
+	}
+}
+
+void UAccelByteSocialToolkit::HandleReadFriendsListComplete(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& Error)
+{
+	if (LocalUserNum == GetLocalUserNum())
+	{
+		CompleteSocialQuery(EAccelByteSocialQuery::Friends, bWasSuccessful);
+	}
+}
+
+namespace
+{
+	template<typename OnlineUserType>
+	TArray<FAccelByteCachedSocialUser> ToCachedSocialUsers(const TArray<TSharedRef<OnlineUserType>>& OnlineUsers)
+	{
+		TArray<FAccelByteCachedSocialUser> CachedUsers;
+		CachedUsers.Reserve(OnlineUsers.Num());
+		for (const TSharedRef<OnlineUserType>& OnlineUser : OnlineUsers)
+		{
+			FAccelByteCachedSocialUser& CachedUser = CachedUsers.AddDefaulted_GetRef();
+			CachedUser.AccelByteId = FUniqueNetIdAccelByteUser::Cast(*OnlineUser->GetUserId())->GetAccelByteId();
+			CachedUser.DisplayName = OnlineUser->GetDisplayName();
+		}
+		return CachedUsers;
+	}
+}
+
+void UAccelByteSocialToolkit::ReconcileSocialListCache(EAccelByteSocialQuery Query)
+{
+	IOnlineSubsystem* Subsystem = GetSocialOss(ESocialSubsystem::Primary);
+	IOnlineFriendsPtr FriendsInterface = Subsystem ? Subsystem->GetFriendsInterface() : nullptr;
+	FUniqueNetIdRepl LocalUserId = GetLocalUserNetId(ESocialSubsystem::Primary);
+	if (!FriendsInterface.IsValid() || !LocalUserId.IsValid())
+	{
+		return;
+	}
+
+	TArray<FAccelByteCachedSocialUser> BackendList;
+	TArray<FAccelByteCachedSocialUser>* CachedList = nullptr;
+	EAccelByteSocialList List = EAccelByteSocialList::None;
+	switch (Query)
+	{
+	case EAccelByteSocialQuery::BlockedPlayers:
+	{
+		TArray<TSharedRef<FOnlineBlockedPlayer>> BlockedPlayers;
+		FriendsInterface->GetBlockedPlayers(*LocalUserId, BlockedPlayers);
+		BackendList = ToCachedSocialUsers(BlockedPlayers);
+		CachedList = &SocialListCache.BlockedPlayers;
+		List = EAccelByteSocialList::BlockedPlayers;
+		break;
+	}
+	case EAccelByteSocialQuery::Friends:
+	{
+		TArray<TSharedRef<FOnlineFriend>> Friends;
+		FriendsInterface->GetFriendsList(GetLocalUserNum(), EFriendsLists::ToString(EFriendsLists::Default), Friends);
+		BackendList = ToCachedSocialUsers(Friends);
+		CachedList = &SocialListCache.Friends;
+		List = EAccelByteSocialList::Friends;
+		break;
+	}
+	case EAccelByteSocialQuery::RecentPlayers:
+	{
+		TArray<TSharedRef<FOnlineRecentPlayer>> RecentPlayers;
+		FriendsInterface->GetRecentPlayers(*LocalUserId, FString(), RecentPlayers);
+		BackendList = ToCachedSocialUsers(RecentPlayers);
+		CachedList = &SocialListCache.RecentPlayers;
+		List = EAccelByteSocialList::RecentPlayers;
+		SocialListCache.RecentPlayersUpdateTime = FDateTime::UtcNow();
+		break;
+	}
+	}
+
+	TArray<FString> AddedIds;
+	TArray<FString> RemovedIds;
+	const bool bChanged = FAccelByteSocialListCache::Reconcile(*CachedList, BackendList, AddedIds, RemovedIds);
+
+	for (const FString& RemovedId : RemovedIds)
+	{
+		SocialUserIndex.Remove(RemovedId, List);
+	}
+	if (bChanged)
+	{
+		SocialUserIndex.AddAll(BackendList, List);
+	}
+
+	if (AddedIds.Num() > 0 || RemovedIds.Num() > 0)
+	{
+		OnSocialListChangedDelegate.Broadcast(Query, AddedIds, RemovedIds);
+	}
+
+	if (bChanged || Query == EAccelByteSocialQuery::RecentPlayers)
+	{
+		SocialListCache.Save();
+	}
+}
+
+void UAccelByteSocialToolkit::RebuildSocialUserIndex()
+{
+	SocialUserIndex.Reset();
+	SocialUserIndex.AddAll(SocialListCache.Friends, EAccelByteSocialList::Friends);
+	SocialUserIndex.AddAll(SocialListCache.BlockedPlayers, EAccelByteSocialList::BlockedPlayers);
+	SocialUserIndex.AddAll(SocialListCache.RecentPlayers, EAccelByteSocialList::RecentPlayers);
+}
+
+bool UAccelByteSocialToolkit::FindSocialListUser(const FString& AccelByteId, FAccelByteCachedSocialUser& OutUser) const
+{
+	if (const FAccelByteSocialUserIndex::FEntry* Entry = SocialUserIndex.Find(AccelByteId))
+	{
+		OutUser = Entry->User;
+		return true;
+	}
+	return false;
+}
+
+USocialUser* UAccelByteSocialToolkit::FindSocialUserByAccelByteId(const FString& AccelByteId) const
+{
+	if (AccelByteId.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	FAccelByteUniqueIdComposite CompositeId;
+	CompositeId.Id = AccelByteId;
+	return FindUser(FUniqueNetIdRepl(FUniqueNetIdAccelByteUser::Create(CompositeId)));
+}
+
+TArray<FAccelByteCachedSocialUser> UAccelByteSocialToolkit::SearchSocialListUsers(const FString& Prefix, int32 MaxResults) const
+{
+	TArray<const FAccelByteSocialUserIndex::FEntry*> Entries;
+	SocialUserIndex.FindByDisplayNamePrefix(Prefix, MaxResults, Entries);
+
+	TArray<FAccelByteCachedSocialUser> Users;
+	Users.Reserve(Entries.Num());
+	for (const FAccelByteSocialUserIndex::FEntry* Entry : Entries)
+	{
+		Users.Add(Entry->User);
+	}
+	return Users;
+}
+
+bool UAccelByteSocialToolkit::IsPlayerBlocked(const FString& AccelByteId) const
+{
+	const FAccelByteSocialUserIndex::FEntry* Entry = SocialUserIndex.Find(AccelByteId);
+	return Entry != nullptr && EnumHasAnyFlags(Entry->Lists, EAccelByteSocialList::BlockedPlayers);
+}
+
+void UAccelByteSocialToolkit::HandlePartyInviteReceivedEx(const FUniqueNetId& LocalUserId, const IOnlinePartyJoinInfo& Invitation)
+{
+	const FUniqueNetIdRef SenderId = Invitation.GetSourceUserId();
+	if (!IsPlayerBlocked(FUniqueNetIdAccelByteUser::Cast(*SenderId)->GetAccelByteId()))
+	{
+		return;
+	}
+
+	UE_LOG(LogAccelByteToolkit, Log, TEXT("Rejecting party invite from blocked player %s"), *SenderId->ToDebugString());
+
+	IOnlineSubsystem* Subsystem = GetSocialOss(ESocialSubsystem::Primary);
+	IOnlinePartyPtr PartyInterface = Subsystem ? Subsystem->GetPartyInterface() : nullptr;
+	if (PartyInterface.IsValid())
+	{
+		PartyInterface->RejectInvitation(LocalUserId, *SenderId);
+	}
+}
+
+void UAccelByteSocialToolkit::HandleFriendRemoved(const FUniqueNetId& UserId, const FUniqueNetId& FriendId)
+{
+	const FString FriendAccelByteId = FUniqueNetIdAccelByteUser::Cast(FriendId)->GetAccelByteId();
+	SocialUserIndex.Remove(FriendAccelByteId, EAccelByteSocialList::Friends);
+
+	if (SocialListCache.Friends.RemoveAllSwap([&FriendAccelByteId](const FAccelByteCachedSocialUser& User) { return User.AccelByteId == FriendAccelByteId; }) > 0)
+	{
+		OnSocialListChangedDelegate.Broadcast(EAccelByteSocialQuery::Friends, TArray<FString>(), TArray<FString>{ FriendAccelByteId });
+		SocialListCache.Save();
+	}
+}
+
+void UAccelByteSocialToolkit::HandleFriendInviteAccepted(const FUniqueNetId& UserId, const FUniqueNetId& FriendId)
+{
+	IOnlineSubsystem* Subsystem = GetSocialOss(ESocialSubsystem::Primary);
+	IOnlineFriendsPtr FriendsInterface = Subsystem ? Subsystem->GetFriendsInterface() : nullptr;
+	const TSharedPtr<FOnlineFriend> Friend = FriendsInterface.IsValid()
+		? FriendsInterface->GetFriend(GetLocalUserNum(), FriendId, EFriendsLists::ToString(EFriendsLists::Default))
+		: nullptr;
+
+	FAccelByteCachedSocialUser User;
+	User.AccelByteId = FUniqueNetIdAccelByteUser::Cast(FriendId)->GetAccelByteId();
+	User.DisplayName = Friend.IsValid() ? Friend->GetDisplayName() : FString();
+
+	const FAccelByteSocialUserIndex::FEntry* Entry = SocialUserIndex.Find(User.AccelByteId);
+	if (Entry == nullptr || !EnumHasAnyFlags(Entry->Lists, EAccelByteSocialList::Friends))
+	{
+		SocialListCache.Friends.Add(User);
+		OnSocialListChangedDelegate.Broadcast(EAccelByteSocialQuery::Friends, TArray<FString>{ User.AccelByteId }, TArray<FString>());
+		SocialListCache.Save();
+	}
+	SocialUserIndex.Add(User, EAccelByteSocialList::Friends);
+}
+
+void UAccelByteSocialToolkit::HandlePresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence)
+{
+	// Presence updates are the most frequent friend event, use them to pick up display name changes of indexed friends
+	const FString AccelByteId = FUniqueNetIdAccelByteUser::Cast(UserId)->GetAccelByteId();
+	const FAccelByteSocialUserIndex::FEntry* Entry = SocialUserIndex.Find(AccelByteId);
+	if (Entry == nullptr || !EnumHasAnyFlags(Entry->Lists, EAccelByteSocialList::Friends))
+	{
+		return;
+	}
+
+	IOnlineSubsystem* Subsystem = GetSocialOss(ESocialSubsystem::Primary);
+	IOnlineFriendsPtr FriendsInterface = Subsystem ? Subsystem->GetFriendsInterface() : nullptr;
+	const TSharedPtr<FOnlineFriend> Friend = FriendsInterface.IsValid()
+		? FriendsInterface->GetFriend(GetLocalUserNum(), UserId, EFriendsLists::ToString(EFriendsLists::Default))
+		: nullptr;
+	if (Friend.IsValid() && Friend->GetDisplayName() != Entry->User.DisplayName)
+	{
+		FAccelByteCachedSocialUser User = Entry->User;
+		User.DisplayName = Friend->GetDisplayName();
+		SocialUserIndex.Add(User, EAccelByteSocialList::Friends);
+	}
+}
+
 void UAccelByteSocialToolkit::OnOwnerLoggedOut()
 {
 	Super::OnOwnerLoggedOut();
 
+	ResetSocialQueries();
+	SocialUserIndex.Reset();
+	PendingPartyActions.Reset();
+	bPartyCreationInFlight = false;
+
 	UE_LOG(LogAccelByteToolkit, Log, TEXT("Local User logged out"));
-	GEngine->SetClientTravel(GetWorld(), *FString("L_LyraFrontEnd"), ETravelType::TRAVEL_Absolute);
+	// Travel by long package name when preloaded, LoadMap only reuses a package it finds under the exact name
+	const FString& TravelMap = (PreloadedLogoutWorld != nullptr) ? LogoutMapPackageName : LogoutMap;
+	GEngine->SetClientTravel(GetWorld(), *TravelMap, ETravelType::TRAVEL_Absolute);
+}
+
+void UAccelByteSocialToolkit::HandlePostLoadMapWithWorld(UWorld* LoadedWorld)
+{
+	if (LoadedWorld == nullptr || LoadedWorld != GetWorld())
+	{
+		return;
+	}
+
+	const FString LoadedPackageName = LoadedWorld->GetOutermost()->GetName();
+	if (LoadedPackageName == LogoutMapPackageName || FPackageName::GetShortName(LoadedPackageName) == LogoutMap)
+	{
+		// The logout map is now the loaded world, it no longer needs to be held
+		PreloadedLogoutWorld = nullptr;
+		return;
+	}
+
+	PreloadLogoutMap();
+}
+
+void UAccelByteSocialToolkit::PreloadLogoutMap()
+{
+	if (PreloadedLogoutWorld != nullptr)
+	{
+		return;
+	}
+
+	if (LogoutMapPackageName.IsEmpty())
+	{
+		if (FPackageName::IsValidLongPackageName(LogoutMap))
+		{
+			LogoutMapPackageName = LogoutMap;
+		}
+		else if (!FPackageName::SearchForPackageOnDisk(LogoutMap + FPackageName::GetMapPackageExtension(), &LogoutMapPackageName))
+		{
+			UE_LOG(LogAccelByteToolkit, Warning, TEXT("Cannot preload logout map %s, the package was not found"), *LogoutMap);
+			bPreloadLogoutMap = false;
+			FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+			return;
+		}
+	}
+
+	LoadPackageAsync(LogoutMapPackageName, FLoadPackageAsyncDelegate::CreateWeakLambda(this,
+		[this](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+		{
+			UWorld* LoadedWorld = (Result == EAsyncLoadingResult::Succeeded && LoadedPackage != nullptr) ? UWorld::FindWorldInPackage(LoadedPackage) : nullptr;
+			if (LoadedWorld != nullptr)
+			{
+				UE_LOG(LogAccelByteToolkit, Log, TEXT("Preloaded logout map %s"), *PackageName.ToString());
+				PreloadedLogoutWorld = LoadedWorld;
+			}
+		}));
 }
@@ -0,0 +1,136 @@
+﻿// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+
+#include "AccelByteSocialUserIndex.h"
+
+#include "Algo/BinarySearch.h"
+
+void FAccelByteSocialUserIndex::Add(const FAccelByteCachedSocialUser& User, EAccelByteSocialList List)
+{
+	if (User.AccelByteId.IsEmpty())
+	{
+		return;
+	}
+
+	if (FEntry* Existing = EntriesById.Find(User.AccelByteId))
+	{
+		Existing->Lists |= List;
+		if (Existing->User.DisplayName != User.DisplayName)
+		{
+			RemoveNameKey(*Existing);
+			Existing->User.DisplayName = User.DisplayName;
+			AddNameKey(*Existing);
+		}
+		return;
+	}
+
+	FEntry& Entry = EntriesById.Add(User.AccelByteId);
+	Entry.User = User;
+	Entry.Lists = List;
+	AddNameKey(Entry);
+}
+
+void FAccelByteSocialUserIndex::Remove(const FString& AccelByteId, EAccelByteSocialList List)
+{
+	FEntry* Existing = EntriesById.Find(AccelByteId);
+	if (Existing == nullptr)
+	{
+		return;
+	}
+
+	Existing->Lists &= ~List;
+	if (Existing->Lists == EAccelByteSocialList::None)
+	{
+		RemoveNameKey(*Existing);
+		EntriesById.Remove(AccelByteId);
+	}
+}
+
+void FAccelByteSocialUserIndex::AddAll(const TArray<FAccelByteCachedSocialUser>& Users, EAccelByteSocialList List)
+{
+	EntriesById.Reserve(EntriesById.Num() + Users.Num());
+	SortedNames.Reserve(SortedNames.Num() + Users.Num());
+
+	// Update known users while the name index is still sorted, then append the new names and sort once,
+	// inserting one by one is quadratic for large lists
+	TArray<const FAccelByteCachedSocialUser*> NewUsers;
+	for (const FAccelByteCachedSocialUser& User : Users)
+	{
+		if (EntriesById.Contains(User.AccelByteId))
+		{
+			Add(User, List);
+		}
+		else if (!User.AccelByteId.IsEmpty())
+		{
+			NewUsers.Add(&User);
+		}
+	}
+
+	for (const FAccelByteCachedSocialUser* User : NewUsers)
+	{
+		if (FEntry* Existing = EntriesById.Find(User->AccelByteId))
+		{
+			// Duplicate within the same list
+			Existing->Lists |= List;
+			continue;
+		}
+
+		FEntry& Entry = EntriesById.Add(User->AccelByteId);
+		Entry.User = *User;
+		Entry.Lists = List;
+		SortedNames.Add(FNameKey{ User->DisplayName.ToLower(), User->AccelByteId });
+	}
+
+	if (NewUsers.Num() > 0)
+	{
+		SortedNames.Sort();
+	}
+}
+
+void FAccelByteSocialUserIndex::Reset()
+{
+	EntriesById.Reset();
+	SortedNames.Reset();
+}
+
+const FAccelByteSocialUserIndex::FEntry* FAccelByteSocialUserIndex::Find(const FString& AccelByteId) const
+{
+	return EntriesById.Find(AccelByteId);
+}
+
+void FAccelByteSocialUserIndex::FindByDisplayNamePrefix(const FString& Prefix, int32 MaxResults, TArray<const FEntry*>& OutEntries) const
+{
+	const FNameKey SearchKey{ Prefix.ToLower(), FString() };
+	for (int32 Index = Algo::LowerBound(SortedNames, SearchKey); Index < SortedNames.Num() && OutEntries.Num() < MaxResults; ++Index)
+	{
+		const FNameKey& Key = SortedNames[Index];
+		if (!Key.Name.StartsWith(SearchKey.Name, ESearchCase::CaseSensitive))
+		{
+			break;
+		}
+
+		if (const FEntry* Entry = EntriesById.Find(Key.AccelByteId))
+		{
+			OutEntries.Add(Entry);
+		}
+	}
+}
+
+void FAccelByteSocialUserIndex::AddNameKey(const FEntry& Entry)
+{
+	FNameKey Key{ Entry.User.DisplayName.ToLower(), Entry.User.AccelByteId };
+	const int32 InsertIndex = Algo::UpperBound(SortedNames, Key);
+	SortedNames.Insert(MoveTemp(Key), InsertIndex);
+}
+
+void FAccelByteSocialUserIndex::RemoveNameKey(const FEntry& Entry)
+{
+	const FNameKey Key{ Entry.User.DisplayName.ToLower(), Entry.User.AccelByteId };
+	const int32 Index = Algo::BinarySearch(SortedNames, Key);
+	if (Index != INDEX_NONE)
+	{
+		SortedNames.RemoveAt(Index, 1, false);
+	}
+}
@@ -6,6 +6,7 @@
 
 #include "CoreMinimal.h"
 #include "Party/PartyMember.h"
+#include "Containers/Ticker.h"
 #include "AccelBytePartyMember.generated.h"
 
 USTRUCT()
@@ -14,7 +15,37 @@ struct FAccelBytePartyMemberRepData : public FPartyMemberRepData
 	GENERATED_BODY()
 public:
 	FAccelBytePartyMemberRepData() = default;
-	
+
+	/** Returns a custom member attribute, or null if it is not set */
+	const FString* FindAttribute(FName Key) const { return Attributes.Find(Key); }
+
+	/**
+	 * Sets a custom member attribute of the local member and marks it dirty.
+	 * The change is not sent until PublishDirtyAttributes is called, returns true if the value changed.
+	 */
+	bool SetAttribute(FName Key, const FString& Value);
+
+	bool HasDirtyAttributes() const { return DirtyAttributes.Num() > 0; }
+
+	/** Sends every attribute changed since the last publish in a single member data update */
+	void PublishDirtyAttributes();
+
+	DECLARE_EVENT_TwoParams(FAccelBytePartyMemberRepData, FOnAttributeChanged, FName /*Key*/, const FString& /*Value*/);
+
+	/** Fired once per attribute whose value changed, removed attributes report an empty value */
+	FOnAttributeChanged& OnAttributeChanged() const { return OnAttributeChangedEvent; }
+
+protected:
+	virtual void CompareAgainst(const FOnlinePartyRepDataBase& OldData) const override;
+
+private:
+	UPROPERTY()
+	TMap<FName, FString> Attributes;
+
+	/** Attributes changed locally since the last publish, not replicated */
+	TSet<FName> DirtyAttributes;
+
+	mutable FOnAttributeChanged OnAttributeChangedEvent;
 };
 
 /**
@@ -26,7 +57,34 @@ class ACCELBYTESOCIALTOOLKIT_API UAccelBytePartyMember : public UPartyMember
 	GENERATED_BODY()
 public:
 	UAccelBytePartyMember();
+	virtual void BeginDestroy() override;
+
+	const FAccelBytePartyMemberRepData& GetAccelByteMemberRepData() const { return RepData; }
+
+	/**
+	 * Sets a custom attribute of the local member, e.g. loadout or ready state.
+	 * Changes are batched and sent at most once per MemberDataPublishInterval.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Party")
+	bool SetMemberAttribute(FName Key, const FString& Value);
+
+	UFUNCTION(BlueprintPure, Category = "AccelByte | Party")
+	FString GetMemberAttribute(FName Key) const;
+
+	/** Immediately sends pending member attribute changes */
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Party")
+	void FlushMemberAttributes();
 
 private:
+	bool HandlePublishTicker(float DeltaTime);
+
 	FAccelBytePartyMemberRepData RepData;
+
+	/** Minimum seconds between two member data updates sent to the party service */
+	float MemberDataPublishInterval = 0.25f;
+
+	/** Time the last member data update was sent */
+	double LastPublishTime = 0.0;
+
+	FTSTicker::FDelegateHandle PublishTickerHandle;
 };
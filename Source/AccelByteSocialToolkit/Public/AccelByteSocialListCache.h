@@ -0,0 +1,65 @@
+﻿// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AccelByteSocialListCache.generated.h"
+
+USTRUCT(BlueprintType)
+struct ACCELBYTESOCIALTOOLKIT_API FAccelByteCachedSocialUser
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | Social")
+	FString AccelByteId;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | Social")
+	FString DisplayName;
+};
+
+/**
+ * On-disk copy of the social lists of one user, shown before the backend queries finish
+ * and reconciled with them afterwards.
+ */
+USTRUCT(BlueprintType)
+struct ACCELBYTESOCIALTOOLKIT_API FAccelByteSocialListCache
+{
+	GENERATED_BODY()
+public:
+	/** Bumped whenever the layout changes, files with another version are discarded */
+	static constexpr int32 CurrentVersion = 1;
+
+	UPROPERTY()
+	int32 Version = CurrentVersion;
+
+	UPROPERTY()
+	FString AccelByteId;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | Social")
+	TArray<FAccelByteCachedSocialUser> Friends;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | Social")
+	TArray<FAccelByteCachedSocialUser> BlockedPlayers;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | Social")
+	TArray<FAccelByteCachedSocialUser> RecentPlayers;
+
+	/** When the recent players list was last reconciled with the backend */
+	UPROPERTY()
+	FDateTime RecentPlayersUpdateTime;
+
+	/** Loads the cache of the given user, returns false and resets the cache if there is no usable file */
+	bool Load(const FString& InAccelByteId);
+	bool Save() const;
+
+	/**
+	 * Replaces a cached list with the backend list, touching only the entries that changed.
+	 * Returns true if anything was added, removed or renamed.
+	 */
+	static bool Reconcile(TArray<FAccelByteCachedSocialUser>& CachedList, const TArray<FAccelByteCachedSocialUser>& BackendList, TArray<FString>& OutAddedIds, TArray<FString>& OutRemovedIds);
+
+private:
+	static FString GetCacheFilePath(const FString& InAccelByteId);
+};
@@ -8,6 +8,29 @@
 #include "Party/SocialParty.h"
 #include "AccelByteSocialParty.generated.h"
 
+/** Session the party leader was matched into, published so members can join it without waiting for their own notification */
+USTRUCT()
+struct ACCELBYTESOCIALTOOLKIT_API FAccelBytePartyFastFollowSession
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString SessionId;
+
+	UPROPERTY()
+	FString ConnectString;
+
+	/** Unix time the leader published the session, used to ignore stale entries */
+	UPROPERTY()
+	int64 PublishedAt = 0;
+
+	bool operator==(const FAccelBytePartyFastFollowSession& Other) const
+	{
+		return SessionId == Other.SessionId && ConnectString == Other.ConnectString && PublishedAt == Other.PublishedAt;
+	}
+	bool operator!=(const FAccelBytePartyFastFollowSession& Other) const { return !(*this == Other); }
+};
+
 USTRUCT()
 struct ACCELBYTESOCIALTOOLKIT_API FAccelBytePartyRepData : public FPartyRepData
 {
@@ -15,8 +38,41 @@ struct ACCELBYTESOCIALTOOLKIT_API FAccelBytePartyRepData : public FPartyRepData
 public:
 	FAccelBytePartyRepData() = default;
 
+	/** Returns a custom party attribute, or null if it is not set */
+	const FString* FindAttribute(FName Key) const { return Attributes.Find(Key); }
+
+	/** Sets a custom party attribute, only the party leader can edit party data. Returns true if the value changed. */
+	bool SetAttribute(FName Key, const FString& Value);
+
+	/** Removes a custom party attribute, returns true if it was set */
+	bool RemoveAttribute(FName Key);
+
+	DECLARE_EVENT_TwoParams(FAccelBytePartyRepData, FOnAttributeChanged, FName /*Key*/, const FString& /*Value*/);
+
+	/** Fired once per attribute whose value changed, removed attributes report an empty value */
+	FOnAttributeChanged& OnAttributeChanged() const { return OnAttributeChangedEvent; }
+
+	const FAccelBytePartyFastFollowSession& GetFastFollowSession() const { return FastFollowSession; }
+
+	/** Publishes the session members should follow, only the party leader can edit party data. Returns true if the value changed. */
+	bool SetFastFollowSession(const FAccelBytePartyFastFollowSession& Session);
+
+	DECLARE_EVENT_OneParam(FAccelBytePartyRepData, FOnFastFollowSessionChanged, const FAccelBytePartyFastFollowSession& /*Session*/);
+	FOnFastFollowSessionChanged& OnFastFollowSessionChanged() const { return OnFastFollowSessionChangedEvent; }
+
 protected:
 	virtual void CompareAgainst(const FOnlinePartyRepDataBase & OldData) const override;
+
+private:
+	UPROPERTY()
+	TMap<FName, FString> Attributes;
+
+	mutable FOnAttributeChanged OnAttributeChangedEvent;
+
+	UPROPERTY()
+	FAccelBytePartyFastFollowSession FastFollowSession;
+
+	mutable FOnFastFollowSessionChanged OnFastFollowSessionChangedEvent;
 };
 
 /**
@@ -29,10 +85,33 @@ class ACCELBYTESOCIALTOOLKIT_API UAccelByteSocialParty : public USocialParty
 public:
 	UAccelByteSocialParty();
 
+	const FAccelBytePartyRepData& GetAccelBytePartyRepData() const { return RepData; }
+
+	/** Sets a custom party attribute, ignored unless the local player leads the party */
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Party")
+	bool SetPartyAttribute(FName Key, const FString& Value);
+
+	UFUNCTION(BlueprintPure, Category = "AccelByte | Party")
+	FString GetPartyAttribute(FName Key) const;
+
 protected:
+	virtual void InitializePartyInternal() override;
 	virtual FPartyPrivacySettings GetDesiredPrivacySettings() const override;
 	virtual TSubclassOf<UPartyMember> GetDesiredMemberClass(bool bLocalPlayer) const override;
 	
 private:
+	/** Leader side, publishes the session matchmaking picked for us */
+	UFUNCTION()
+	void HandleMatchmakingSessionChosen(const FString& SessionId, const FString& ConnectString);
+
+	/** Member side, joins the session the leader published */
+	void HandleFastFollowSessionChanged(const FAccelBytePartyFastFollowSession& Session);
+
 	FAccelBytePartyRepData RepData;
+
+	/** If true, members of the persistent party join the leader's matchmade session as soon as the leader publishes it */
+	bool bPartyFastFollow = true;
+
+	/** Published sessions older than this many seconds are ignored */
+	float FastFollowMaxAge = 60.f;
 };
@@ -6,8 +6,30 @@
 
 #include "CoreMinimal.h"
 #include "SocialToolkit.h"
+#include "Containers/Ticker.h"
+#include "AccelByteSocialListCache.h"
+#include "AccelByteSocialUserIndex.h"
 #include "AccelByteSocialToolkit.generated.h"
 
+class FOnlineUserPresence;
+class IOnlinePartyJoinInfo;
+class IOnlineFriends;
+class IOnlinePresence;
+class IOnlinePartySystem;
+class UCommonSessionSubsystem;
+class UWorld;
+
+/** Social list queries issued after the lobby connects, in the order they are scheduled */
+UENUM(BlueprintType)
+enum class EAccelByteSocialQuery : uint8
+{
+	/** Needed first, session and party filtering depends on it */
+	BlockedPlayers,
+	Friends,
+	/** Only started once the other queries are done and the toolkit has been idle for a while */
+	RecentPlayers
+};
+
 /**
  * 
  */
@@ -17,15 +39,184 @@ class ACCELBYTESOCIALTOOLKIT_API UAccelByteSocialToolkit : public USocialToolkit
 	GENERATED_BODY()
 public:
 	virtual void InitializeToolkit(ULocalPlayer& InOwningLocalPlayer) override;
+	virtual void BeginDestroy() override;
 	UAccelByteSocialToolkit();
 
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLobbyConnectedDelegate);
 
 	FOnLobbyConnectedDelegate OnLobbyConnectedDelegate;
 
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSocialQueryReadyDelegate, EAccelByteSocialQuery, Query, bool, bWasSuccessful);
+
+	/** Called each time one of the scheduled social queries finishes */
+	UPROPERTY(BlueprintAssignable)
+	FOnSocialQueryReadyDelegate OnSocialQueryReadyDelegate;
+
+	/** Returns true once the given social query has finished since the last login */
+	UFUNCTION(BlueprintPure, Category = "AccelByte | Social")
+	bool IsSocialQueryReady(EAccelByteSocialQuery Query) const;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSocialListCacheLoadedDelegate);
+
+	/** Called on lobby connect once the cached social lists of the user are available */
+	UPROPERTY(BlueprintAssignable)
+	FOnSocialListCacheLoadedDelegate OnSocialListCacheLoadedDelegate;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSocialListChangedDelegate, EAccelByteSocialQuery, Query, const TArray<FString>&, AddedIds, const TArray<FString>&, RemovedIds);
+
+	/** Called when reconciling a cached list with the backend added or removed users */
+	UPROPERTY(BlueprintAssignable)
+	FOnSocialListChangedDelegate OnSocialListChangedDelegate;
+
+	/** Returns the cached social lists, filled from disk on lobby connect and kept in sync with the backend */
+	UFUNCTION(BlueprintPure, Category = "AccelByte | Social")
+	FAccelByteSocialListCache GetSocialListCache() const { return SocialListCache; }
+
+	/** Looks up a user of any social list by AccelByte id, returns false if the user is unknown */
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Social")
+	bool FindSocialListUser(const FString& AccelByteId, FAccelByteCachedSocialUser& OutUser) const;
+
+	/** Returns the social user object for an AccelByte id, or null if the toolkit does not know the user yet */
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Social")
+	USocialUser* FindSocialUserByAccelByteId(const FString& AccelByteId) const;
+
+	/** Returns true if the user is on the blocked list of the local user */
+	UFUNCTION(BlueprintPure, Category = "AccelByte | Social")
+	bool IsPlayerBlocked(const FString& AccelByteId) const;
+
+	/** Returns users of any social list whose display name starts with Prefix, ignoring case */
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Social")
+	TArray<FAccelByteCachedSocialUser> SearchSocialListUsers(const FString& Prefix, int32 MaxResults = 20) const;
+
+	DECLARE_DELEGATE_OneParam(FOnPersistentPartyReady, USocialParty* /*Party*/);
+
+	/**
+	 * Runs OnReady with the persistent party, creating the party first if the user is not in one yet.
+	 * Concurrent calls share one creation request, Party is null if creating it failed.
+	 */
+	void EnsurePersistentParty(const FOnPersistentPartyReady& OnReady);
+
+	/** Invites a user to the persistent party, creating the party first if needed */
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Party")
+	bool InviteToPersistentParty(const FString& AccelByteId);
+
 protected:
 	void OnCreatePartyComplete(ECreatePartyCompletionResult CreatePartyCompletionResult);
 	virtual void OnLobbyConnected(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& Error);
 
 	virtual void OnOwnerLoggedOut() override;
+
+	/** Creates the default party, on login if the toolkit is configured to do it or on first use in lazy mode */
+	void CreateDefaultParty();
+
+	/** Adds a query to the schedule, keeping the pending list ordered by priority */
+	void ScheduleSocialQuery(EAccelByteSocialQuery Query);
+	/** Starts as many pending queries as the concurrency limit allows */
+	void PumpSocialQueries();
+	void StartSocialQuery(EAccelByteSocialQuery Query);
+	void CompleteSocialQuery(EAccelByteSocialQuery Query, bool bWasSuccessful);
+	void ResetSocialQueries();
+	bool TickSocialQueries(float DeltaTime);
+
+	void HandleQueryBlockedPlayersComplete(const FUniqueNetId& UserId, bool bWasSuccessful, const FString& Error);
+	void HandleQueryRecentPlayersComplete(const FUniqueNetId& UserId, const FString& Namespace, bool bWasSuccessful, const FString& Error);
+	void HandleReadFriendsListComplete(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& Error);
+
+	/** True if the id belongs to the local player owning this toolkit, friends interface notifications are shared by every local user */
+	bool IsOwningUser(const FUniqueNetId& UserId) const;
+
+	/** Applies the backend result of a finished query to the cached list and saves it */
+	void ReconcileSocialListCache(EAccelByteSocialQuery Query);
+
+	/** Rebuilds the user index from the cached lists */
+	void RebuildSocialUserIndex();
+
+	void HandleFriendRemoved(const FUniqueNetId& UserId, const FUniqueNetId& FriendId);
+	void HandleFriendInviteAccepted(const FUniqueNetId& UserId, const FUniqueNetId& FriendId);
+	void HandlePresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence);
+
+	/** Rejects invites sent by blocked players before they reach the party UI */
+	void HandlePartyInviteReceivedEx(const FUniqueNetId& LocalUserId, const IOnlinePartyJoinInfo& Invitation);
+
+	/** Keeps the logout map loaded in the background while the player is on another map */
+	void HandlePostLoadMapWithWorld(UWorld* LoadedWorld);
+	void PreloadLogoutMap();
+
+private:
+	/** Queries waiting to be started, highest priority first */
+	TArray<EAccelByteSocialQuery> PendingSocialQueries;
+
+	/** Queries that have been started, with the time they were started at */
+	TMap<EAccelByteSocialQuery, double> InFlightSocialQueries;
+
+	/** Queries that finished since the last login */
+	TSet<EAccelByteSocialQuery> ReadySocialQueries;
+
+	/** Maximum number of social queries running at the same time */
+	int32 MaxConcurrentSocialQueries = 1;
+
+	/** Seconds without any running social query before recent players are queried */
+	float RecentPlayersQueryDelay = 5.0f;
+
+	/** Seconds after which a query without a completion notification is treated as done */
+	float SocialQueryTimeout = 15.0f;
+
+	/** Time the last social query finished, used to detect idle */
+	double LastSocialQueryCompleteTime = 0.0;
+
+	/** True if the default party should be created once the blocked and friends lists are ready */
+	bool bCreatePartyWhenReady = false;
+
+	/** If true the default party is only created once an action needs it, instead of on login */
+	bool bLazyCreateParty = false;
+
+	/** True while a default party creation request is waiting for its result */
+	bool bPartyCreationInFlight = false;
+
+	/** Actions waiting for the default party to be created */
+	TArray<FOnPersistentPartyReady> PendingPartyActions;
+
+	/** Session subsystem whose matchmaking party requests this toolkit handles, set in lazy mode only */
+	TWeakObjectPtr<UCommonSessionSubsystem> MatchmakingSessionSubsystem;
+
+	FTSTicker::FDelegateHandle SocialQueryTickerHandle;
+
+	/** Social lists of the owning user as last known, persisted between runs */
+	FAccelByteSocialListCache SocialListCache;
+
+	/** Cached recent players older than this many seconds are not shown while the recent players query is pending */
+	float RecentPlayersCacheMaxAge = 600.0f;
+
+	/** Id and display name lookups over every user in the cached lists */
+	FAccelByteSocialUserIndex SocialUserIndex;
+
+	/** Map the owning player is sent back to on logout, short or long package name */
+	FString LogoutMap = TEXT("L_LyraFrontEnd");
+
+	/** If true the logout map package is loaded in the background during gameplay so logout does not wait on a full map load */
+	bool bPreloadLogoutMap = false;
+
+	/** Long package name of LogoutMap, resolved on first preload */
+	FString LogoutMapPackageName;
+
+	/**
+	 * World of the preloaded logout map, held so it is not garbage collected until it is traveled to.
+	 * The package alone does not keep the world inside it alive. LoadMap finds the package in memory and uses this world.
+	 */
+	UPROPERTY(Transient)
+	TObjectPtr<UWorld> PreloadedLogoutWorld;
+
+	FDelegateHandle PostLoadMapHandle;
+
+	/** Interfaces the toolkit bound its handlers to, the handlers are removed from them when the toolkit is destroyed */
+	TWeakPtr<IOnlineFriends, ESPMode::ThreadSafe> BoundFriendsInterface;
+	TWeakPtr<IOnlinePresence, ESPMode::ThreadSafe> BoundPresenceInterface;
+	TWeakPtr<IOnlinePartySystem, ESPMode::ThreadSafe> BoundPartyInterface;
+
+	FDelegateHandle QueryBlockedPlayersCompleteHandle;
+	FDelegateHandle QueryRecentPlayersCompleteHandle;
+	FDelegateHandle FriendRemovedHandle;
+	FDelegateHandle FriendInviteAcceptedHandle;
+	FDelegateHandle PresenceReceivedHandle;
+	FDelegateHandle PartyInviteReceivedExHandle;
 };
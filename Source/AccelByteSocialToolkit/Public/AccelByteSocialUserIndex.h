@@ -0,0 +1,73 @@
+﻿// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AccelByteSocialListCache.h"
+
+/** Social lists a user can be part of */
+enum class EAccelByteSocialList : uint8
+{
+	None = 0,
+	Friends = 1 << 0,
+	BlockedPlayers = 1 << 1,
+	RecentPlayers = 1 << 2
+};
+ENUM_CLASS_FLAGS(EAccelByteSocialList);
+
+/**
+ * Lookup structures over every user in the social lists of the local user:
+ * a hash index by AccelByte id and a sorted, case-insensitive display name index for prefix search.
+ * Both are updated per user so large lists never need a full rebuild after the initial load.
+ */
+class ACCELBYTESOCIALTOOLKIT_API FAccelByteSocialUserIndex
+{
+public:
+	struct FEntry
+	{
+		FAccelByteCachedSocialUser User;
+		EAccelByteSocialList Lists = EAccelByteSocialList::None;
+	};
+
+	/** Adds the user to a list, or updates its display name if it is already indexed */
+	void Add(const FAccelByteCachedSocialUser& User, EAccelByteSocialList List);
+
+	/** Removes the user from a list, the user is dropped from the index once it is in no list */
+	void Remove(const FString& AccelByteId, EAccelByteSocialList List);
+
+	/** Indexes every user of a list, used after loading the cache */
+	void AddAll(const TArray<FAccelByteCachedSocialUser>& Users, EAccelByteSocialList List);
+
+	void Reset();
+
+	const FEntry* Find(const FString& AccelByteId) const;
+
+	/** Appends up to MaxResults users whose display name starts with Prefix, ignoring case */
+	void FindByDisplayNamePrefix(const FString& Prefix, int32 MaxResults, TArray<const FEntry*>& OutEntries) const;
+
+	int32 Num() const { return EntriesById.Num(); }
+
+private:
+	struct FNameKey
+	{
+		/** Lower case display name */
+		FString Name;
+		FString AccelByteId;
+
+		bool operator<(const FNameKey& Other) const
+		{
+			const int32 Compare = Name.Compare(Other.Name, ESearchCase::CaseSensitive);
+			return Compare != 0 ? Compare < 0 : AccelByteId.Compare(Other.AccelByteId, ESearchCase::CaseSensitive) < 0;
+		}
+	};
+
+	void AddNameKey(const FEntry& Entry);
+	void RemoveNameKey(const FEntry& Entry);
+
+	TMap<FString, FEntry> EntriesById;
+
+	/** Sorted by lower case display name so prefix matches are a contiguous range */
+	TArray<FNameKey> SortedNames;
+};
@@ -55,6 +55,10 @@ public class CommonUser : ModuleRules
 				"SlateCore",
 				"ApplicationCore",
 				"InputCore",
+				"AssetRegistry",
+				"Json",
+				"JsonUtilities",
+				"Sockets",
 				"Party", 
 				"OnlineSubsystemAccelByte"
 				// ... add private dependencies that you statically link with here ...	
@@ -0,0 +1,151 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#include "CommonMatchmakingQueueStats.h"
+
+#include "Algo/BinarySearch.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+//////////////////////////////////////////////////////////////////////
+// FCommonMatchmakingQueueHistogram
+
+const TArray<float>& FCommonMatchmakingQueueHistogram::GetBucketUpperBounds()
+{
+	// Finer buckets where most matches happen, the last one catches everything longer
+	static const TArray<float> UpperBounds = { 5.f, 10.f, 15.f, 20.f, 30.f, 45.f, 60.f, 90.f, 120.f, 180.f, 300.f, 600.f, TNumericLimits<float>::Max() };
+	return UpperBounds;
+}
+
+void FCommonMatchmakingQueueHistogram::AddSample(float Seconds, float Decay)
+{
+	const TArray<float>& UpperBounds = GetBucketUpperBounds();
+	BucketWeights.SetNumZeroed(UpperBounds.Num());
+
+	for (float& Weight : BucketWeights)
+	{
+		Weight *= Decay;
+	}
+
+	const int32 Bucket = Algo::LowerBound(UpperBounds, FMath::Max(Seconds, 0.f));
+	BucketWeights[FMath::Min(Bucket, UpperBounds.Num() - 1)] += 1.f;
+
+	NumSamples++;
+	LastSampleTime = FDateTime::UtcNow();
+}
+
+TOptional<float> FCommonMatchmakingQueueHistogram::GetPercentile(float Fraction) const
+{
+	const TArray<float>& UpperBounds = GetBucketUpperBounds();
+	float TotalWeight = 0.f;
+	for (const float Weight : BucketWeights)
+	{
+		TotalWeight += Weight;
+	}
+	if (TotalWeight <= 0.f || BucketWeights.Num() != UpperBounds.Num())
+	{
+		return TOptional<float>();
+	}
+
+	// Walk the cumulative weight and interpolate linearly inside the bucket the fraction falls into
+	const float Target = FMath::Clamp(Fraction, 0.f, 1.f) * TotalWeight;
+	float Cumulative = 0.f;
+	for (int32 Index = 0; Index < BucketWeights.Num(); Index++)
+	{
+		const float Weight = BucketWeights[Index];
+		if (Weight > 0.f && Cumulative + Weight >= Target)
+		{
+			const float Lower = Index > 0 ? UpperBounds[Index - 1] : 0.f;
+			// The open ended bucket has no width to interpolate in, report its lower bound
+			const float Upper = Index < UpperBounds.Num() - 1 ? UpperBounds[Index] : Lower;
+			return Lower + (Upper - Lower) * ((Target - Cumulative) / Weight);
+		}
+		Cumulative += Weight;
+	}
+	return UpperBounds.Num() > 1 ? UpperBounds[UpperBounds.Num() - 2] : 0.f;
+}
+
+float FCommonMatchmakingQueueHistogram::GetFractionBelow(float Seconds) const
+{
+	const TArray<float>& UpperBounds = GetBucketUpperBounds();
+	if (BucketWeights.Num() != UpperBounds.Num())
+	{
+		return 0.f;
+	}
+
+	float TotalWeight = 0.f;
+	float BelowWeight = 0.f;
+	for (int32 Index = 0; Index < BucketWeights.Num(); Index++)
+	{
+		const float Weight = BucketWeights[Index];
+		const float Lower = Index > 0 ? UpperBounds[Index - 1] : 0.f;
+		const float Upper = UpperBounds[Index];
+		TotalWeight += Weight;
+		if (Seconds >= Upper)
+		{
+			BelowWeight += Weight;
+		}
+		else if (Seconds > Lower && Index < UpperBounds.Num() - 1)
+		{
+			BelowWeight += Weight * ((Seconds - Lower) / (Upper - Lower));
+		}
+	}
+	return TotalWeight > 0.f ? BelowWeight / TotalWeight : 0.f;
+}
+
+//////////////////////////////////////////////////////////////////////
+// FCommonMatchmakingQueueStats
+
+bool FCommonMatchmakingQueueStats::Load()
+{
+	*this = FCommonMatchmakingQueueStats();
+
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetFilePath()))
+	{
+		return false;
+	}
+
+	FCommonMatchmakingQueueStats Loaded;
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &Loaded, 0, 0) || Loaded.Version != CurrentVersion)
+	{
+		// Outdated or corrupted, start over
+		return false;
+	}
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
+
+bool FCommonMatchmakingQueueStats::Save() const
+{
+	FString JsonString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(*this, JsonString, 0, 0))
+	{
+		return false;
+	}
+
+	return FFileHelper::SaveStringToFile(JsonString, *GetFilePath());
+}
+
+const FCommonMatchmakingQueueHistogram* FCommonMatchmakingQueueStats::Find(const FString& Queue) const
+{
+	return Queues.FindByPredicate([&Queue](const FCommonMatchmakingQueueHistogram& Histogram) { return Histogram.Queue == Queue; });
+}
+
+FCommonMatchmakingQueueHistogram& FCommonMatchmakingQueueStats::FindOrAdd(const FString& Queue)
+{
+	if (FCommonMatchmakingQueueHistogram* Existing = Queues.FindByPredicate([&Queue](const FCommonMatchmakingQueueHistogram& Histogram) { return Histogram.Queue == Queue; }))
+	{
+		return *Existing;
+	}
+
+	FCommonMatchmakingQueueHistogram& Added = Queues.AddDefaulted_GetRef();
+	Added.Queue = Queue;
+	return Added;
+}
+
+FString FCommonMatchmakingQueueStats::GetFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("CommonUser") / TEXT("MatchmakingQueueStats.json");
+}
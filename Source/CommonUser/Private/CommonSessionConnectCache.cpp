@@ -0,0 +1,166 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#include "CommonSessionConnectCache.h"
+
+#include "IPAddress.h"
+#include "SocketSubsystem.h"
+
+namespace CommonSessionConnectCache
+{
+	/** Resolved addresses older than this are looked up again, so a moved server is not connected to by a stale address */
+	static constexpr double MaxAddressAge = 300.0;
+
+	/** P2P connect strings address a peer through the AccelByte net driver, there is nothing to resolve */
+	static const TCHAR* const PeerHostPrefix = TEXT("accelbyte.");
+}
+
+FCommonSessionConnectCache::~FCommonSessionConnectCache()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	for (FPendingHost& Pending : PendingHosts)
+	{
+		// A running lookup cannot be destroyed, the socket subsystem finishes it and the info is leaked
+		if (Pending.ResolveInfo->IsComplete())
+		{
+			delete Pending.ResolveInfo;
+		}
+	}
+}
+
+void FCommonSessionConnectCache::Prefetch(const FString& ConnectString)
+{
+	FString Host;
+	FString Remainder;
+	if (!SplitHost(ConnectString, Host, Remainder) || Host.StartsWith(CommonSessionConnectCache::PeerHostPrefix))
+	{
+		return;
+	}
+
+	if (const FResolvedHost* Resolved = ResolvedHosts.Find(Host))
+	{
+		if (FPlatformTime::Seconds() - Resolved->ResolveTime < CommonSessionConnectCache::MaxAddressAge)
+		{
+			return;
+		}
+	}
+
+	if (PendingHosts.ContainsByPredicate([&Host](const FPendingHost& Pending) { return Pending.Host == Host; }))
+	{
+		return;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (SocketSubsystem == nullptr)
+	{
+		return;
+	}
+
+	// Numeric addresses need no lookup
+	if (SocketSubsystem->GetAddressFromString(Host).IsValid())
+	{
+		return;
+	}
+
+	FResolveInfo* ResolveInfo = SocketSubsystem->GetHostByName(TCHAR_TO_ANSI(*Host));
+	if (ResolveInfo == nullptr)
+	{
+		return;
+	}
+
+	PendingHosts.Add({ Host, ResolveInfo });
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCommonSessionConnectCache::Tick));
+	}
+}
+
+FString FCommonSessionConnectCache::Apply(const FString& ConnectString) const
+{
+	FString Host;
+	FString Remainder;
+	if (!SplitHost(ConnectString, Host, Remainder))
+	{
+		return ConnectString;
+	}
+
+	const FResolvedHost* Resolved = ResolvedHosts.Find(Host);
+	if (Resolved == nullptr || FPlatformTime::Seconds() - Resolved->ResolveTime >= CommonSessionConnectCache::MaxAddressAge)
+	{
+		return ConnectString;
+	}
+
+	return Resolved->Address + Remainder;
+}
+
+void FCommonSessionConnectCache::Reset()
+{
+	ResolvedHosts.Empty();
+}
+
+bool FCommonSessionConnectCache::SplitHost(const FString& ConnectString, FString& OutHost, FString& OutRemainder)
+{
+	// Connect strings are host:port, possibly followed by URL options
+	int32 HostEnd = INDEX_NONE;
+	if (ConnectString.StartsWith(TEXT("[")))
+	{
+		// IPv6 literals are numeric already
+		return false;
+	}
+
+	ConnectString.FindChar(TEXT(':'), HostEnd);
+	if (HostEnd == INDEX_NONE)
+	{
+		ConnectString.FindChar(TEXT('?'), HostEnd);
+	}
+	if (HostEnd == INDEX_NONE)
+	{
+		HostEnd = ConnectString.Len();
+	}
+
+	OutHost = ConnectString.Left(HostEnd);
+	OutRemainder = ConnectString.Mid(HostEnd);
+	return !OutHost.IsEmpty();
+}
+
+bool FCommonSessionConnectCache::Tick(float DeltaTime)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+	for (int32 Index = PendingHosts.Num() - 1; Index >= 0; --Index)
+	{
+		FPendingHost& Pending = PendingHosts[Index];
+		if (!Pending.ResolveInfo->IsComplete())
+		{
+			continue;
+		}
+
+		if (Pending.ResolveInfo->GetErrorCode() == 0)
+		{
+			const FInternetAddr& Address = Pending.ResolveInfo->GetResolvedAddress();
+			FString AddressString = Address.ToString(false);
+			if (AddressString.Contains(TEXT(":")))
+			{
+				// IPv6 results need brackets to be followed by a port
+				AddressString = FString::Printf(TEXT("[%s]"), *AddressString);
+			}
+			ResolvedHosts.Add(Pending.Host, { AddressString, FPlatformTime::Seconds() });
+
+			// Anything else that resolves this host by name is served from the socket subsystem cache
+			if (SocketSubsystem != nullptr)
+			{
+				SocketSubsystem->AddHostNameToCache(TCHAR_TO_ANSI(*Pending.Host), Address.Clone());
+			}
+		}
+
+		delete Pending.ResolveInfo;
+		PendingHosts.RemoveAtSwap(Index);
+	}
+
+	if (PendingHosts.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,7 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#pragma once
+
+#include "Logging/LogMacros.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogCommonSession, Log, All);
@@ -0,0 +1,118 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#include "CommonSessionMapCatalog.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/AssetManager.h"
+
+FCommonSessionMapCatalog::FCommonSessionMapCatalog(const TArray<FPrimaryAssetType>& InAssetTypes, const TArray<FName>& InMatchmakingTagKeys)
+	: AssetTypes(InAssetTypes)
+	, MatchmakingTagKeys(InMatchmakingTagKeys)
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FCommonSessionMapCatalog::Invalidate);
+		AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FCommonSessionMapCatalog::HandleAssetChanged);
+		AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FCommonSessionMapCatalog::HandleAssetChanged);
+		AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FCommonSessionMapCatalog::HandleAssetRenamed);
+	}
+}
+
+FCommonSessionMapCatalog::~FCommonSessionMapCatalog()
+{
+	// During shutdown the asset registry may already be gone
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+}
+
+const FCommonSessionMapCatalogEntry* FCommonSessionMapCatalog::Find(const FPrimaryAssetId& MapID)
+{
+	if (!MapID.IsValid())
+	{
+		return nullptr;
+	}
+
+	if (bDirty)
+	{
+		Rebuild();
+	}
+
+	if (const FCommonSessionMapCatalogEntry* Entry = Entries.Find(MapID))
+	{
+		return Entry;
+	}
+
+	// Maps of a type that was not indexed up front are resolved once and then cached
+	FAssetData MapAssetData;
+	if (UAssetManager::IsValid() && UAssetManager::Get().GetPrimaryAssetData(MapID, /*out*/ MapAssetData))
+	{
+		return &AddEntry(MapID, MapAssetData);
+	}
+
+	return nullptr;
+}
+
+void FCommonSessionMapCatalog::Invalidate()
+{
+	bDirty = true;
+}
+
+void FCommonSessionMapCatalog::Rebuild()
+{
+	if (!UAssetManager::IsValid())
+	{
+		// Try again on the next lookup
+		return;
+	}
+
+	Entries.Reset();
+	bDirty = false;
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	TArray<FAssetData> AssetDataList;
+	for (const FPrimaryAssetType& AssetType : AssetTypes)
+	{
+		AssetDataList.Reset();
+		AssetManager.GetPrimaryAssetDataList(AssetType, /*out*/ AssetDataList);
+		for (const FAssetData& AssetData : AssetDataList)
+		{
+			AddEntry(AssetManager.GetPrimaryAssetIdForData(AssetData), AssetData);
+		}
+	}
+}
+
+const FCommonSessionMapCatalogEntry& FCommonSessionMapCatalog::AddEntry(const FPrimaryAssetId& MapID, const FAssetData& AssetData)
+{
+	FCommonSessionMapCatalogEntry& Entry = Entries.Add(MapID);
+	Entry.MapID = MapID;
+	Entry.PackageName = AssetData.PackageName.ToString();
+	Entry.AdvertisedName = AssetData.AssetName.ToString();
+
+	for (const FName& TagKey : MatchmakingTagKeys)
+	{
+		FString TagValue;
+		if (AssetData.GetTagValue(TagKey, /*out*/ TagValue))
+		{
+			Entry.MatchmakingTags.Add(TagKey, MoveTemp(TagValue));
+		}
+	}
+
+	return Entry;
+}
+
+void FCommonSessionMapCatalog::HandleAssetChanged(const FAssetData& AssetData)
+{
+	Invalidate();
+}
+
+void FCommonSessionMapCatalog::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	Invalidate();
+}
@@ -4,13 +4,24 @@
 
 #include <OnlineSessionInterfaceV1AccelByte.h>
 
+#include "CommonSessionMapCatalog.h"
+#include "CommonSessionConnectCache.h"
+#include "CommonMatchmakingQueueStats.h"
+#include "CommonSessionLog.h"
+
 #include "OnlineSubsystemAccelByte.h"
 #include "OnlineSubsystemAccelByteDefines.h"
+#include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlineSubsystemAccelByteTypes.h"
+#include "GameFramework/GameMode.h"
 #include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/GameSession.h"
+#include "GameFramework/GameStateBase.h"
 #include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
 #include "Engine/LocalPlayer.h"
+#include "TimerManager.h"
 
 #if COMMONUSER_OSSV1
 #include "OnlineSubsystem.h"
@@ -18,6 +29,8 @@
 #include "OnlineSubsystemSessionSettings.h"
 #include "OnlineSubsystemUtils.h"
 #include "Interfaces/OnlineIdentityInterface.h"
+#include "Interfaces/OnlineFriendsInterface.h"
+#include "Interfaces/OnlinePartyInterface.h"
 
 FName SETTING_ONLINESUBSYSTEM_VERSION(TEXT("OSSv1"));
 #else
@@ -29,7 +42,6 @@ using namespace UE::Online;
 #endif // COMMONUSER_OSSV1
 
 
-DECLARE_LOG_CATEGORY_EXTERN(LogCommonSession, Log, All);
 DEFINE_LOG_CATEGORY(LogCommonSession);
 
 #define LOCTEXT_NAMESPACE "CommonUser"
@@ -201,6 +213,68 @@ public:
 	}
 
 	virtual ~FCommonSession_OnlineSessionSettings() {}
+
+	/** Sets a value and marks it dirty, returns false if the value was already set */
+	template<typename ValueType>
+	bool SetTracked(FName Key, const ValueType& Value, EOnlineDataAdvertisementType::Type InType)
+	{
+		ValueType ExistingValue;
+		if (Get(Key, ExistingValue) && ExistingValue == Value)
+		{
+			return false;
+		}
+
+		Set(Key, Value, InType);
+		DirtySettings.Add(Key);
+		return true;
+	}
+
+	/** Sets the public connection count and marks it dirty, returns false if it was unchanged */
+	bool SetNumPublicConnectionsTracked(int32 InNumPublicConnections)
+	{
+		InNumPublicConnections = FMath::Max(InNumPublicConnections, 0);
+		if (NumPublicConnections == InNumPublicConnections)
+		{
+			return false;
+		}
+
+		NumPublicConnections = InNumPublicConnections;
+		bNumPublicConnectionsDirty = true;
+		return true;
+	}
+
+	bool IsDirty() const
+	{
+		return bNumPublicConnectionsDirty || DirtySettings.Num() > 0;
+	}
+
+	/** Copies only the values changed since the last ClearDirty onto the target settings */
+	void ApplyDirtyTo(FOnlineSessionSettings& Target) const
+	{
+		for (const FName& Key : DirtySettings)
+		{
+			if (const FOnlineSessionSetting* Setting = Settings.Find(Key))
+			{
+				Target.Settings.Add(Key, *Setting);
+			}
+		}
+
+		if (bNumPublicConnectionsDirty)
+		{
+			Target.NumPublicConnections = NumPublicConnections;
+		}
+	}
+
+	void ClearDirty()
+	{
+		DirtySettings.Reset();
+		bNumPublicConnectionsDirty = false;
+	}
+
+private:
+	/** Keys changed since the last session update */
+	TSet<FName> DirtySettings;
+	bool bNumPublicConnectionsDirty = false;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -255,11 +329,137 @@ public:
 
 #endif // COMMONUSER_OSSV1
 
+//////////////////////////////////////////////////////////////////////
+// FCommonSessionTeardown
+
+enum class ECommonSessionTeardownStep : uint8
+{
+	None,
+	Ending,
+	Destroying,
+	Waiting
+};
+
+struct FCommonSessionTeardown
+{
+	FCommonSessionTeardown(FName InSessionName, bool bInFastLeave)
+		: SessionName(InSessionName)
+		, bFastLeave(bInFastLeave)
+	{
+	}
+
+	FName SessionName;
+	bool bFastLeave = false;
+
+	/** Step that is currently waiting on the online system */
+	ECommonSessionTeardownStep Step = ECommonSessionTeardownStep::None;
+
+	/** Number of times the current step has been issued */
+	int32 StepAttempts = 0;
+
+	FTimerHandle StepTimeoutHandle;
+
+	/** One promise per caller that is waiting on this teardown */
+	TArray<TPromise<bool>> Waiters;
+};
+
+#if COMMONUSER_OSSV1
+//////////////////////////////////////////////////////////////////////
+// FCommonMatchmakingTicket
+
+struct FCommonMatchmakingTicket
+{
+	FCommonMatchmakingTicket(const FString& InQueue, const TSharedRef<FCommonOnlineSearchSettings>& InSearch)
+		: Queue(InQueue)
+		, Search(InSearch)
+	{
+	}
+
+	/** Matchmaking queue (AccelByte game mode) of the ticket */
+	FString Queue;
+
+	TSharedRef<FCommonOnlineSearchSettings> Search;
+};
+
+//////////////////////////////////////////////////////////////////////
+// FCommonMatchmakingRetry
+
+/** The original matchmaking request, kept so failed attempts can be re-submitted without the caller */
+struct FCommonMatchmakingRetry
+{
+	TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest;
+
+	/** Search request handed to the caller, only notified once the final attempt finishes */
+	TStrongObjectPtr<UCommonSession_SearchSessionRequest> SearchRequest;
+
+	TWeakObjectPtr<APlayerController> Player;
+
+	/** Number of attempts submitted so far */
+	int32 Attempt = 1;
+
+	FTimerHandle RetryTimerHandle;
+};
+#endif // COMMONUSER_OSSV1
+
+//////////////////////////////////////////////////////////////////////
+// FCommonQuickPlayJoin
+
+/** Ranked search results of a quick play, tried in order until one can be joined */
+struct FCommonQuickPlayJoin
+{
+	TWeakObjectPtr<APlayerController> Player;
+
+	/** Hosted if no candidate can be joined */
+	TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest;
+
+	/** Candidates that have not been tried yet, best first */
+	TArray<TStrongObjectPtr<UCommonSession_SearchResult>> Candidates;
+
+	/** Candidate whose join is in flight, other join results do not belong to the quick play */
+	TStrongObjectPtr<UCommonSession_SearchResult> JoiningCandidate;
+
+	/** Number of joins issued so far */
+	int32 Attempts = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+// FCommonQuickPlayRace
+
+/** Host side of a quick play, prepared while the search is still running */
+struct FCommonQuickPlayRace
+{
+	TWeakObjectPtr<APlayerController> Player;
+	TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest;
+
+	/** Search the host is racing against, unbound once the race is settled */
+	TWeakObjectPtr<UCommonSession_SearchSessionRequest> SearchRequest;
+
+	FTimerHandle DeadlineTimerHandle;
+
+	/** True while the unadvertised session is being created */
+	bool bPreCreating = false;
+
+	/** True once the unadvertised session exists */
+	bool bPreCreated = false;
+
+	/** Outcome decided while the session was still being created, applied when creation completes */
+	bool bCommitted = false;
+	bool bDiscarded = false;
+	TFunction<void()> OnDiscarded;
+};
+
 //////////////////////////////////////////////////////////////////////
 // UCommonSession_HostSessionRequest
 
 FString UCommonSession_HostSessionRequest::GetMapName() const
 {
+	if (const UCommonSessionSubsystem* Subsystem = GetTypedOuter<UCommonSessionSubsystem>())
+	{
+		const FCommonSessionMapCatalogEntry* Entry = Subsystem->FindMapCatalogEntry(MapID);
+		return Entry ? Entry->PackageName : FString();
+	}
+
+	// Requests created outside of the subsystem don't have access to the catalog
 	FAssetData MapAssetData;
 	if (UAssetManager::Get().GetPrimaryAssetData(MapID, /*out*/ MapAssetData))
 	{
@@ -273,16 +473,26 @@ FString UCommonSession_HostSessionRequest::GetMapName() const
 
 FString UCommonSession_HostSessionRequest::ConstructTravelURL() const
 {
-	FString CombinedExtraArgs;
+	FString URL = GetMapName();
+	GetTravelOptions().AppendTo(URL);
+
+	//bIsRecordingDemo ? TEXT("?DemoRec") : TEXT(""));
+
+	return URL;
+}
+
+FCommonSessionTravelOptions UCommonSession_HostSessionRequest::GetTravelOptions() const
+{
+	FCommonSessionTravelOptions Options;
 
 	if (OnlineMode == ECommonSessionOnlineMode::LAN)
 	{
-		CombinedExtraArgs += TEXT("?bIsLanMatch");
+		Options.SetFlag(CommonSessionTravelOption::LanMatch);
 	}
 	
 	if (OnlineMode != ECommonSessionOnlineMode::Offline)
 	{
-		CombinedExtraArgs += TEXT("?listen");
+		Options.SetFlag(CommonSessionTravelOption::Listen);
 	}
 
 	for (const auto& KVP : ExtraArgs)
@@ -291,20 +501,32 @@ FString UCommonSession_HostSessionRequest::ConstructTravelURL() const
 		{
 			if (KVP.Value.IsEmpty())
 			{
-				CombinedExtraArgs += FString::Printf(TEXT("?%s"), *KVP.Key);
+				Options.SetFlag(FName(*KVP.Key));
 			}
 			else
 			{
-				CombinedExtraArgs += FString::Printf(TEXT("?%s=%s"), *KVP.Key, *KVP.Value);
+				Options.SetString(FName(*KVP.Key), KVP.Value);
 			}
 		}
 	}
 
-	//bIsRecordingDemo ? TEXT("?DemoRec") : TEXT(""));
+	Options.Merge(TravelOptions);
+	return Options;
+}
+
+void UCommonSession_HostSessionRequest::SetIntTravelOption(FName Key, int32 Value)
+{
+	TravelOptions.SetInt(Key, Value);
+}
+
+void UCommonSession_HostSessionRequest::SetBoolTravelOption(FName Key, bool Value)
+{
+	TravelOptions.SetBool(Key, Value);
+}
 
-	return FString::Printf(TEXT("%s%s"),
-		*GetMapName(),
-		*CombinedExtraArgs);
+void UCommonSession_HostSessionRequest::SetStringTravelOption(FName Key, const FString& Value)
+{
+	TravelOptions.SetString(Key, Value);
 }
 
 bool UCommonSession_HostSessionRequest::ValidateAndLogErrors() const
@@ -329,10 +551,23 @@ int32 UCommonSession_HostSessionRequest::GetMaxPlayers() const
 void UCommonSessionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+	MapCatalog = MakeShared<FCommonSessionMapCatalog>(MapCatalogAssetTypes, MapCatalogMatchmakingTags);
+	ConnectCache = MakeShared<FCommonSessionConnectCache>();
+	MatchmakingQueueStats.Load();
 	BindOnlineDelegates();
 	GEngine->OnTravelFailure().AddUObject(this, &UCommonSessionSubsystem::TravelLocalSessionFailure);
 
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UCommonSessionSubsystem::HandlePostLoadMap);
+
+	if ((bServerPlayerRoster || bServerSessionAutopilot) && IsRunningDedicatedServer())
+	{
+		FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &UCommonSessionSubsystem::HandleServerPostLogin);
+		FGameModeEvents::GameModeLogoutEvent.AddUObject(this, &UCommonSessionSubsystem::HandleServerLogout);
+	}
+	if (bServerSessionAutopilot && IsRunningDedicatedServer())
+	{
+		FGameModeEvents::OnGameModeMatchStateSetEvent().AddUObject(this, &UCommonSessionSubsystem::HandleServerMatchStateSet);
+	}
 }
 
 void UCommonSessionSubsystem::BindOnlineDelegates()
@@ -389,6 +624,29 @@ void UCommonSessionSubsystem::BindOnlineDelegatesOSSv1()
 //	THREE_PARAM(OnUnregisterPlayersComplete, FName, const TArray< FUniqueNetIdRef >&, bool);
 
 	SessionInterface->AddOnSessionFailureDelegate_Handle(FOnSessionFailureDelegate::CreateUObject(this, &ThisClass::HandleSessionFailure));
+
+	// #START @AccelByte Implementation Blocked players
+	// The social toolkit queries the blocked list after the lobby connects, mirror it here so search results can be filtered
+	const IOnlineFriendsPtr FriendsInterface = OnlineSub->GetFriendsInterface();
+	if (FriendsInterface.IsValid())
+	{
+		FriendsInterface->AddOnQueryBlockedPlayersCompleteDelegate_Handle(FOnQueryBlockedPlayersCompleteDelegate::CreateUObject(this, &ThisClass::HandleQueryBlockedPlayersComplete));
+		for (int32 LocalUserNum = 0; LocalUserNum < MAX_LOCAL_PLAYERS; LocalUserNum++)
+		{
+			FriendsInterface->AddOnBlockedPlayerCompleteDelegate_Handle(LocalUserNum, FOnBlockedPlayerCompleteDelegate::CreateUObject(this, &ThisClass::HandleBlockedPlayerComplete));
+			FriendsInterface->AddOnUnblockedPlayerCompleteDelegate_Handle(LocalUserNum, FOnUnblockedPlayerCompleteDelegate::CreateUObject(this, &ThisClass::HandleUnblockedPlayerComplete));
+		}
+	}
+
+	const IOnlineIdentityPtr IdentityInterface = OnlineSub->GetIdentityInterface();
+	if (IdentityInterface.IsValid())
+	{
+		for (int32 LocalUserNum = 0; LocalUserNum < MAX_LOCAL_PLAYERS; LocalUserNum++)
+		{
+			IdentityInterface->AddOnLoginStatusChangedDelegate_Handle(LocalUserNum, FOnLoginStatusChangedDelegate::CreateUObject(this, &ThisClass::HandleBlockedListOwnerLoginStatusChanged));
+		}
+	}
+	// #END
 }
 
 #else
@@ -401,6 +659,43 @@ void UCommonSessionSubsystem::BindOnlineDelegatesOSSv2()
 	check(OnlineServices);
 	ILobbiesPtr Lobbies = OnlineServices->GetLobbiesInterface();
 	check(Lobbies);
+
+	// Mirror joined lobbies locally so lookups by session name don't have to query every joined lobby
+	LobbyEventHandles.Add(Lobbies->OnLobbyJoined().Add(this, &ThisClass::HandleLobbyJoined));
+	LobbyEventHandles.Add(Lobbies->OnLobbyLeft().Add(this, &ThisClass::HandleLobbyLeft));
+	LobbyEventHandles.Add(Lobbies->OnLobbyAttributesChanged().Add([this](const FLobbyAttributesChanged& Event) { HandleLobbyUpdated(Event.Lobby); }));
+	LobbyEventHandles.Add(Lobbies->OnLobbyMemberJoined().Add([this](const FLobbyMemberJoined& Event) { HandleLobbyUpdated(Event.Lobby); }));
+	LobbyEventHandles.Add(Lobbies->OnLobbyMemberLeft().Add([this](const FLobbyMemberLeft& Event) { HandleLobbyUpdated(Event.Lobby); }));
+	LobbyEventHandles.Add(Lobbies->OnLobbyLeaderChanged().Add([this](const FLobbyLeaderChanged& Event) { HandleLobbyUpdated(Event.Lobby); }));
+}
+
+void UCommonSessionSubsystem::HandleLobbyJoined(const FLobbyJoined& LobbyJoined)
+{
+	UE_LOG(LogCommonSession, Verbose, TEXT("Lobby joined (LobbyId: %s, LocalName: %s)"), *ToLogString(LobbyJoined.Lobby->LobbyId), *LobbyJoined.Lobby->LocalName.ToString());
+	JoinedLobbies.Add(LobbyJoined.Lobby->LocalName, LobbyJoined.Lobby);
+}
+
+void UCommonSessionSubsystem::HandleLobbyLeft(const FLobbyLeft& LobbyLeft)
+{
+	UE_LOG(LogCommonSession, Verbose, TEXT("Lobby left (LobbyId: %s, LocalName: %s)"), *ToLogString(LobbyLeft.Lobby->LobbyId), *LobbyLeft.Lobby->LocalName.ToString());
+
+	const TSharedRef<const FLobby>* Existing = JoinedLobbies.Find(LobbyLeft.Lobby->LocalName);
+	if (Existing && (*Existing)->LobbyId == LobbyLeft.Lobby->LobbyId)
+	{
+		JoinedLobbies.Remove(LobbyLeft.Lobby->LocalName);
+	}
+}
+
+void UCommonSessionSubsystem::HandleLobbyUpdated(const TSharedRef<const FLobby>& Lobby)
+{
+	// Only lobbies we are in are mirrored, updates for anything else are ignored
+	if (TSharedRef<const FLobby>* Existing = JoinedLobbies.Find(Lobby->LocalName))
+	{
+		if ((*Existing)->LobbyId == Lobby->LobbyId)
+		{
+			*Existing = Lobby;
+		}
+	}
 }
 #endif
 
@@ -418,6 +713,13 @@ void UCommonSessionSubsystem::Deinitialize()
 			SessionInterface->ClearOnSessionFailureDelegates(this);
 		}
 	}
+#else
+	for (FOnlineEventDelegateHandle& Handle : LobbyEventHandles)
+	{
+		Handle.Unbind();
+	}
+	LobbyEventHandles.Empty();
+	JoinedLobbies.Empty();
 #endif // COMMONUSER_OSSV1
 
 	if (GEngine)
@@ -426,6 +728,22 @@ void UCommonSessionSubsystem::Deinitialize()
 	}
 
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+	if (SessionNameWorld.IsValid())
+	{
+		SessionNameWorld->RemoveOnActorSpawnedHandler(SessionNameActorSpawnedHandle);
+	}
+	SessionNameWorld.Reset();
+	FGameModeEvents::GameModePostLoginEvent.RemoveAll(this);
+	FGameModeEvents::GameModeLogoutEvent.RemoveAll(this);
+	FGameModeEvents::OnGameModeMatchStateSetEvent().RemoveAll(this);
+
+	if (ActiveTeardown.IsValid())
+	{
+		FinishTeardown(false);
+	}
+
+	MapCatalog.Reset();
+	ConnectCache.Reset();
 
 	Super::Deinitialize();
 }
@@ -439,6 +757,11 @@ bool UCommonSessionSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 	return ChildClasses.Num() == 0;
 }
 
+const FCommonSessionMapCatalogEntry* UCommonSessionSubsystem::FindMapCatalogEntry(const FPrimaryAssetId& MapID) const
+{
+	return MapCatalog.IsValid() ? MapCatalog->Find(MapID) : nullptr;
+}
+
 bool UCommonSessionSubsystem::IsLocalPlayerHostingSession() const
 {
 	const IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
@@ -450,7 +773,7 @@ bool UCommonSessionSubsystem::IsLocalPlayerHostingSession() const
 	const IOnlineIdentityPtr OnlineIdentity = OnlineSub->GetIdentityInterface();
 	check(OnlineIdentity.IsValid());
 
-	const FNamedOnlineSession* Session = Sessions->GetNamedSession(NAME_GameSession);
+	const FNamedOnlineSession* Session = Sessions->GetNamedSession(ActiveSessionName);
 	return Session->bHosting;
 }
 
@@ -534,9 +857,7 @@ void UCommonSessionSubsystem::CreateOnlineSessionInternal(ULocalPlayer* LocalPla
 #if COMMONUSER_OSSV1
 void UCommonSessionSubsystem::CreateOnlineSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_HostSessionRequest* Request)
 {
-	const FName SessionName(NAME_GameSession);
-	const int32 MaxPlayers = Request->GetMaxPlayers();
-	const bool bIsPresence = Request->bUseLobbies; // Using lobbies implies presence
+	const FName SessionName(ActiveSessionName);
 
 	IOnlineSubsystem* const OnlineSub = Online::GetSubsystem(GetWorld());
 	check(OnlineSub);
@@ -548,26 +869,13 @@ void UCommonSessionSubsystem::CreateOnlineSessionInternalOSSv1(ULocalPlayer* Loc
 
 	if (ensure(UserId.IsValid()))
 	{
-		HostSettings = MakeShareable(new FCommonSession_OnlineSessionSettings(Request->OnlineMode == ECommonSessionOnlineMode::LAN, bIsPresence, MaxPlayers));
-		HostSettings->bUseLobbiesIfAvailable = Request->bUseLobbies;
-		HostSettings->Set(SETTING_GAMEMODE, Request->ModeNameForAdvertisement, EOnlineDataAdvertisementType::ViaOnlineService);
-		HostSettings->Set(SETTING_MAPNAME, Request->GetMapName(), EOnlineDataAdvertisementType::ViaOnlineService);
-		//@TODO: HostSettings->Set(SETTING_MATCHING_HOPPER, FString("TeamDeathmatch"), EOnlineDataAdvertisementType::DontAdvertise);
-		HostSettings->Set(SETTING_MATCHING_TIMEOUT, 120.0f, EOnlineDataAdvertisementType::ViaOnlineService);
-		HostSettings->Set(SETTING_SESSION_TEMPLATE_NAME, FString(TEXT("GameSession")), EOnlineDataAdvertisementType::DontAdvertise);
-		HostSettings->Set(SETTING_ONLINESUBSYSTEM_VERSION, true, EOnlineDataAdvertisementType::ViaOnlineService);
+		HostSettings = BuildHostSettingsOSSv1(Request);
 
 		// #START @AccelByte Implementation
-		HostSettings->Set(SETTING_ACCELBYTE_ICE_ENABLED, Request->ServerType == ECommonSessionOnlineServerType::P2P, EOnlineDataAdvertisementType::ViaOnlineService);
-		HostSettings->bIsDedicated = Request->ServerType == ECommonSessionOnlineServerType::Dedicated;
-		FString* NumBots = Request->ExtraArgs.Find(TEXT("NumBots"));
-		if(NumBots)
-		{
-			HostSettings->Set<int>(SETTING_NUMBOTS, FCString::Atoi(**NumBots), EOnlineDataAdvertisementType::ViaOnlineService);
-		}
-		else
+		// A racing quick play keeps its session out of searches until it commits to hosting
+		if (QuickPlayRace.IsValid() && QuickPlayRace->bPreCreating)
 		{
-			HostSettings->Set<int>(SETTING_NUMBOTS, 0, EOnlineDataAdvertisementType::ViaOnlineService);
+			HostSettings->bShouldAdvertise = false;
 		}
 		// #END
 
@@ -582,6 +890,41 @@ void UCommonSessionSubsystem::CreateOnlineSessionInternalOSSv1(ULocalPlayer* Loc
 	}
 }
 
+TSharedRef<FCommonSession_OnlineSessionSettings> UCommonSessionSubsystem::BuildHostSettingsOSSv1(const UCommonSession_HostSessionRequest* Request) const
+{
+	const int32 MaxPlayers = Request->GetMaxPlayers();
+	const bool bIsPresence = Request->bUseLobbies; // Using lobbies implies presence
+
+	TSharedRef<FCommonSession_OnlineSessionSettings> Settings = MakeShareable(new FCommonSession_OnlineSessionSettings(Request->OnlineMode == ECommonSessionOnlineMode::LAN, bIsPresence, MaxPlayers));
+	Settings->bUseLobbiesIfAvailable = Request->bUseLobbies;
+	Settings->Set(SETTING_GAMEMODE, Request->ModeNameForAdvertisement, EOnlineDataAdvertisementType::ViaOnlineService);
+	if (const FCommonSessionMapCatalogEntry* MapEntry = FindMapCatalogEntry(Request->MapID))
+	{
+		Settings->Set(SETTING_MAPNAME, MapEntry->PackageName, EOnlineDataAdvertisementType::ViaOnlineService);
+		for (const TPair<FName, FString>& Tag : MapEntry->MatchmakingTags)
+		{
+			Settings->Set(Tag.Key, Tag.Value, EOnlineDataAdvertisementType::ViaOnlineService);
+		}
+	}
+	else
+	{
+		Settings->Set(SETTING_MAPNAME, Request->GetMapName(), EOnlineDataAdvertisementType::ViaOnlineService);
+	}
+	//@TODO: Settings->Set(SETTING_MATCHING_HOPPER, FString("TeamDeathmatch"), EOnlineDataAdvertisementType::DontAdvertise);
+	Settings->Set(SETTING_MATCHING_TIMEOUT, 120.0f, EOnlineDataAdvertisementType::ViaOnlineService);
+	Settings->Set(SETTING_SESSION_TEMPLATE_NAME, FString(TEXT("GameSession")), EOnlineDataAdvertisementType::DontAdvertise);
+	Settings->Set(SETTING_ONLINESUBSYSTEM_VERSION, true, EOnlineDataAdvertisementType::ViaOnlineService);
+
+	// #START @AccelByte Implementation
+	Settings->Set(SETTING_ACCELBYTE_ICE_ENABLED, Request->ServerType == ECommonSessionOnlineServerType::P2P, EOnlineDataAdvertisementType::ViaOnlineService);
+	Settings->bIsDedicated = Request->ServerType == ECommonSessionOnlineServerType::Dedicated;
+	const FCommonSessionTravelOptions TravelOptions = Request->GetTravelOptions();
+	Settings->Set<int>(SETTING_NUMBOTS, TravelOptions.GetInt(CommonSessionTravelOption::NumBots).Get(0), EOnlineDataAdvertisementType::ViaOnlineService);
+	// #END
+
+	return Settings;
+}
+
 #else
 
 void UCommonSessionSubsystem::CreateOnlineSessionInternalOSSv2(ULocalPlayer* LocalPlayer, UCommonSession_HostSessionRequest* Request)
@@ -592,7 +935,7 @@ void UCommonSessionSubsystem::CreateOnlineSessionInternalOSSv2(ULocalPlayer* Loc
 		Request->bUseLobbies = true;
 	}
 
-	const FName SessionName(NAME_GameSession);
+	const FName SessionName(ActiveSessionName);
 	const int32 MaxPlayers = Request->GetMaxPlayers();
 	const bool bIsPresence = Request->bUseLobbies; // Using lobbies implies presence
 
@@ -626,6 +969,10 @@ void UCommonSessionSubsystem::CreateOnlineSessionInternalOSSv2(ULocalPlayer* Loc
 
 	Lobbies->CreateLobby(MoveTemp(CreateParams)).OnComplete(this, [this, SessionName](const TOnlineResult<FCreateLobby>& CreateResult)
 	{
+		if (CreateResult.IsOk())
+		{
+			JoinedLobbies.Add(SessionName, CreateResult.GetOkValue().Lobby);
+		}
 		OnCreateSessionComplete(SessionName, CreateResult.IsOk());
 	});
 }
@@ -636,6 +983,34 @@ void UCommonSessionSubsystem::OnCreateSessionComplete(FName SessionName, bool bW
 {
 	UE_LOG(LogCommonSession, Log, TEXT("OnCreateSessionComplete(SessionName: %s, bWasSuccessful: %d)"), *SessionName.ToString(), bWasSuccessful);
 
+	if (QuickPlayRace.IsValid() && QuickPlayRace->bPreCreating)
+	{
+		// The racing quick play decides whether this session is used, it is not traveled to yet
+		HandleQuickPlayRaceSessionCreated(bWasSuccessful);
+		return;
+	}
+
+	if (bWasSuccessful && bServerPlayerRoster && SessionName == ActiveSessionName
+		&& (PendingServerRegistrations.Num() > 0 || PendingServerUnregistrations.Num() > 0))
+	{
+		// Players that logged in before the session existed were deferred, register them now
+		QueueServerRosterFlush();
+	}
+
+	if (bArmingServerWarmSession && SessionName == ActiveSessionName)
+	{
+		// Warm sessions are created in place on the dedicated server, there is nothing to travel to
+		HandleServerWarmSessionCreated(bWasSuccessful);
+		return;
+	}
+
+	if (bRecyclingServerSession && SessionName == ActiveSessionName)
+	{
+		// The server is already on its map, a recycled session must not trigger the host travel
+		HandleServerSessionRecreated(bWasSuccessful);
+		return;
+	}
+
 	if (bWasSuccessful)
 	{
 		OnSessionCreatedDelegate.Broadcast();
@@ -704,13 +1079,77 @@ void UCommonSessionSubsystem::OnUpdateSessionComplete(FName SessionName, bool bW
 void UCommonSessionSubsystem::OnEndSessionComplete(FName SessionName, bool bWasSuccessful)
 {
 	UE_LOG(LogCommonSession, Log, TEXT("OnEndSessionComplete(SessionName: %s, bWasSuccessful: %s)"), *SessionName.ToString(), bWasSuccessful ? TEXT("true") : TEXT("false"));
-	CleanUpSessions();
+
+	if (!ActiveTeardown.IsValid() || ActiveTeardown->SessionName != SessionName)
+	{
+		if (bServerSessionAutopilot && IsRunningDedicatedServer() && SessionName == ActiveSessionName)
+		{
+			// The autopilot keeps the ended session until its players are gone and recycles it from there
+			UpdateServerSessionAutopilot();
+			return;
+		}
+
+		// Only the session being played takes the game down with it, an ended next match is just dropped
+		if (SessionName == ActiveSessionName)
+		{
+			CleanUpSessions();
+		}
+		else if (SessionName == GetNextSessionName())
+		{
+			LeaveNextSession();
+		}
+		return;
+	}
+
+	if (!bWasSuccessful)
+	{
+		// Removing the session from the session browser can hang and leave the session stuck in Ending,
+		// put it back in progress so the next attempt issues EndSession again
+		IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+		FNamedOnlineSession* Session = Sessions.IsValid() ? Sessions->GetNamedSession(SessionName) : nullptr;
+		if (Session && Session->SessionState == EOnlineSessionState::Ending)
+		{
+			Session->SessionState = EOnlineSessionState::InProgress;
+		}
+	}
+
+	AdvanceTeardownOSSv1();
 }
 
 void UCommonSessionSubsystem::OnDestroySessionComplete(FName SessionName, bool bWasSuccessful)
 {
 	UE_LOG(LogCommonSession, Log, TEXT("OnDestroySessionComplete(SessionName: %s, bWasSuccessful: %s)"), *SessionName.ToString(), bWasSuccessful ? TEXT("true") : TEXT("false"));
 	bWantToDestroyPendingSession = false;
+
+	if (ActiveTeardown.IsValid() && ActiveTeardown->SessionName == SessionName)
+	{
+		if (bWasSuccessful)
+		{
+			FinishTeardown(true);
+		}
+		else
+		{
+			AdvanceTeardownOSSv1();
+		}
+	}
+
+	if (bWasSuccessful && SessionName == ActiveSessionName && ServerWarmSessionTemplate && !bRecyclingServerSession)
+	{
+		// The match that claimed the warm session is over, arm the next one right away
+		bServerWarmSessionReady = false;
+		GetGameInstance()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::CreateServerWarmSession));
+	}
+
+	if (bWasSuccessful && SessionName == ActiveSessionName && bServerPlayerRoster)
+	{
+		// Registrations belonged to the destroyed session, players still connected are registered again with the next one
+		PendingServerUnregistrations.Reset();
+		PendingServerRegistrations.Reset();
+		for (const TPair<FString, FUniqueNetIdRef>& Entry : ServerRoster)
+		{
+			PendingServerRegistrations.Add(Entry.Key);
+		}
+	}
 }
 
 
@@ -727,6 +1166,12 @@ void UCommonSessionSubsystem::OnMatchmakingStarted()
 		
 		SearchSettings = CreateMatchmakingSearchSettings(HostRequest, MatchRequest);
 	}
+
+	// Queue time is measured per request, retries and alternate tickets keep the original start
+	if (MatchmakingStartTime == 0.0)
+	{
+		MatchmakingStartTime = FPlatformTime::Seconds();
+	}
 	
 	OnMatchmakingStartDelegate.Broadcast();
 }
@@ -735,12 +1180,30 @@ void UCommonSessionSubsystem::OnMatchmakingComplete(FName SessionName, bool bWas
 {
 	UE_LOG(LogCommonSession, Log, TEXT("OnMatchmakingComplete(SessionName: %s, bWasSuccessful: %s)"), *SessionName.ToString(), bWasSuccessful ? TEXT("true") : TEXT("false"));
 
+	if (bWasSuccessful)
+	{
+		FinishReadyConsent(true);
+	}
+
 	if(!SearchSettings.IsValid())
 	{
 		// matchmaking is failed or canceled
 		return;
 	}
 
+	if (const TSharedPtr<FCommonMatchmakingTicket> Ticket = MoveTemp(ActiveMatchmakingTicket))
+	{
+		if (!bWasSuccessful && StartNextMatchmakingQueue())
+		{
+			UE_LOG(LogCommonSession, Log, TEXT("Matchmaking ticket for queue %s failed, failing over to the next queue"), *Ticket->Queue);
+			return;
+		}
+
+		UE_LOG(LogCommonSession, Log, TEXT("Matchmaking ticket for queue %s finished (bWasSuccessful: %s)"), *Ticket->Queue, bWasSuccessful ? TEXT("true") : TEXT("false"));
+		PendingMatchmakingQueues.Reset();
+		SearchSettings = Ticket->Search;
+	}
+
 	// For a user that don't start matchmaking (on a party), the FOnlineSessionSearch will not referenced from this class
 	// instead created by AccelByte OSS.
 	if(SearchSettings->SearchResults.Num() == 0)
@@ -779,6 +1242,13 @@ void UCommonSessionSubsystem::OnMatchmakingComplete(FName SessionName, bool bWas
 		return;
 	}
 
+	if ((!bWasSuccessful || SearchSettingsV1.SearchResults.Num() == 0) && ScheduleMatchmakingRetry())
+	{
+		return;
+	}
+	MatchmakingRetry.Reset();
+	MatchmakingStartTime = 0.0;
+
 	if (bWasSuccessful)
 	{
 		SearchSettingsV1.SearchRequest->Results.Reset(SearchSettingsV1.SearchResults.Num());
@@ -810,6 +1280,23 @@ void UCommonSessionSubsystem::OnMatchmakingTimeout(const FErrorInfo& Error)
 {
 	UE_LOG(LogCommonSession, Log, TEXT("OnMatchmakingTimeoutDelegate"));
 
+	if (const TSharedPtr<FCommonMatchmakingTicket> Ticket = MoveTemp(ActiveMatchmakingTicket))
+	{
+		if (StartNextMatchmakingQueue())
+		{
+			UE_LOG(LogCommonSession, Log, TEXT("Matchmaking ticket for queue %s timed out, failing over to the next queue"), *Ticket->Queue);
+			return;
+		}
+	}
+
+	if (ScheduleMatchmakingRetry())
+	{
+		return;
+	}
+	MatchmakingRetry.Reset();
+	MatchmakingStartTime = 0.0;
+	FinishReadyConsent(false);
+
 	SearchSettings.Reset();
 	OnMatchmakingTimeoutDelegate.Broadcast(Error);
 	CleanUpSessions();
@@ -818,11 +1305,125 @@ void UCommonSessionSubsystem::OnMatchmakingTimeout(const FErrorInfo& Error)
 void UCommonSessionSubsystem::OnMatchFound(FString MatchId)
 {
 	UE_LOG(LogCommonSession, Log, TEXT("OnMatchFoundDelegate"));
-	
-	OnMatchFoundDelegate.Broadcast(MatchId);
-}
-
-// #END
+
+	if (MatchmakingStartTime > 0.0)
+	{
+		FString Queue;
+		if (ActiveMatchmakingTicket.IsValid())
+		{
+			Queue = ActiveMatchmakingTicket->Queue;
+		}
+		else if (SearchSettings.IsValid())
+		{
+			SearchSettings->QuerySettings.Get(SETTING_GAMEMODE, Queue);
+		}
+
+		if (!Queue.IsEmpty())
+		{
+			const float QueueTime = static_cast<float>(FPlatformTime::Seconds() - MatchmakingStartTime);
+			FCommonMatchmakingQueueHistogram& Histogram = MatchmakingQueueStats.FindOrAdd(Queue);
+			Histogram.AddSample(QueueTime, FMath::Clamp(MatchmakingQueueStatsDecay, 0.0f, 1.0f));
+			MatchmakingQueueStats.Save();
+
+			UE_LOG(LogCommonSession, Log, TEXT("Matchmaking queue time sample (Queue: %s, Seconds: %.1f, Median: %.1f)"),
+				*Queue, QueueTime, Histogram.GetPercentile(0.5f).Get(QueueTime));
+		}
+		MatchmakingStartTime = 0.0;
+	}
+
+	PendingReadyConsentMatchId = MatchId;
+	ReadyConsentRequestTime = FPlatformTime::Seconds();
+	ReadyConsentSentTime = 0.0;
+
+	// Confirm before the game gets the notification, UI bound to it may take a while to get to the consent
+	const ULocalPlayer* LocalPlayer = GetGameInstance()->GetFirstGamePlayer();
+	if (ShouldAutoConfirmReadyConsent(LocalPlayer))
+	{
+		SendReadyConsent(LocalPlayer);
+	}
+	
+	OnMatchFoundDelegate.Broadcast(MatchId);
+}
+
+bool UCommonSessionSubsystem::ShouldAutoConfirmReadyConsent(const ULocalPlayer* LocalPlayer) const
+{
+	switch (ReadyConsentPolicy)
+	{
+	case ECommonReadyConsentPolicy::Always:
+		return true;
+	case ECommonReadyConsentPolicy::InParty:
+	{
+		const FUniqueNetIdPtr UserId = LocalPlayer ? LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId() : nullptr;
+		const IOnlinePartyPtr PartyInterface = Online::GetPartyInterface(GetWorld());
+		if (!UserId.IsValid() || !PartyInterface.IsValid())
+		{
+			return false;
+		}
+
+		TArray<TSharedRef<const FOnlinePartyId>> JoinedParties;
+		PartyInterface->GetJoinedParties(*UserId, JoinedParties);
+		for (const TSharedRef<const FOnlinePartyId>& PartyId : JoinedParties)
+		{
+			TArray<FOnlinePartyMemberConstRef> Members;
+			if (PartyInterface->GetPartyMembers(*UserId, *PartyId, Members) && Members.Num() > 1)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	default:
+		return false;
+	}
+}
+
+bool UCommonSessionSubsystem::SendReadyConsent(const ULocalPlayer* LocalPlayer)
+{
+	if (PendingReadyConsentMatchId.IsEmpty() || ReadyConsentSentTime > 0.0 || LocalPlayer == nullptr)
+	{
+		return false;
+	}
+
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
+	if (OnlineSub == nullptr || !OnlineSub->GetSubsystemName().IsEqual(TEXT("AccelByte"), ENameCase::IgnoreCase))
+	{
+		return false;
+	}
+
+	FOnlineIdentityAccelBytePtr IdentityAccelByte = StaticCastSharedPtr<FOnlineIdentityAccelByte>(OnlineSub->GetIdentityInterface());
+	AccelByte::FApiClientPtr ApiClient = IdentityAccelByte.IsValid() ? IdentityAccelByte->GetApiClient(LocalPlayer->GetLocalPlayerIndex()) : nullptr;
+	if (!ApiClient.IsValid())
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("Could not send ready consent for match %s, no API client for the local player"), *PendingReadyConsentMatchId);
+		return false;
+	}
+
+	ApiClient->Lobby.SendReadyConsentRequest(PendingReadyConsentMatchId);
+	ReadyConsentSentTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogCommonSession, Log, TEXT("Sent ready consent for match %s (%.2fs after the request)"),
+		*PendingReadyConsentMatchId, ReadyConsentSentTime - ReadyConsentRequestTime);
+	return true;
+}
+
+void UCommonSessionSubsystem::FinishReadyConsent(bool bMatchReady)
+{
+	if (ReadyConsentRequestTime > 0.0 && bMatchReady)
+	{
+		const double Now = FPlatformTime::Seconds();
+		LastReadyConsentRoundTrip = static_cast<float>(Now - ReadyConsentRequestTime);
+
+		UE_LOG(LogCommonSession, Log, TEXT("Ready consent round trip for match %s: %.2fs (confirmed after %.2fs)"),
+			*PendingReadyConsentMatchId, LastReadyConsentRoundTrip,
+			ReadyConsentSentTime > 0.0 ? ReadyConsentSentTime - ReadyConsentRequestTime : -1.0);
+	}
+
+	PendingReadyConsentMatchId.Reset();
+	ReadyConsentRequestTime = 0.0;
+	ReadyConsentSentTime = 0.0;
+}
+
+// #END
 
 #endif // COMMONUSER_OSSV1
 
@@ -894,13 +1495,46 @@ void UCommonSessionSubsystem::FindSessionsInternalOSSv1(ULocalPlayer* LocalPlaye
 			SearchSettings->QuerySettings.Set(SETTING_GAMEMODE, OverrideMatchmakingMode, EOnlineComparisonOp::Equals);
 		}
 		
-		TSharedRef<FOnlineSessionSearch> SearchSession = ConstCastSharedRef<FCommonOnlineSearchSettingsOSSv1>(SearchSettings.ToSharedRef());
-		Sessions->StartMatchmaking(
-			{LocalPlayer->GetPreferredUniqueNetId()->AsShared()},
-			NAME_GameSession,
-			FOnlineSessionSettings(),
-			SearchSession
-		);
+		const FUniqueNetIdRef LocalUserId = LocalPlayer->GetPreferredUniqueNetId()->AsShared();
+		MatchmakingUserId = LocalUserId;
+		ActiveMatchmakingTicket.Reset();
+
+		auto StartMatchmaking = [this, GameMode]()
+		{
+			// The search settings of the request are the ticket for its primary queue, alternates get their own copies
+			if (!StartMatchmakingTicketOSSv1(SearchSettings.ToSharedRef(), GameMode))
+			{
+				StartNextMatchmakingQueue();
+			}
+		};
+
+		// Matchmaking is done as a party. If the social toolkit creates the party on first use, the user may
+		// not be in one yet, so matchmaking starts from the party creation instead of failing the request.
+		const bool bWaitForParty = EnsureMatchmakingPartyDelegate.IsBound() && EnsureMatchmakingPartyDelegate.Execute(LocalPlayer,
+			FOnMatchmakingPartyReady::CreateWeakLambda(this, [this, StartMatchmaking, LocalSearchSettings = SearchSettings](bool bWasSuccessful)
+			{
+				if (LocalSearchSettings != SearchSettings)
+				{
+					// Matchmaking was canceled while the party was created
+					return;
+				}
+
+				if (bWasSuccessful)
+				{
+					StartMatchmaking();
+				}
+				else
+				{
+					UE_LOG(LogCommonSession, Error, TEXT("FindSessionsInternalOSSv1: failed to create a party for matchmaking"));
+					SearchSettings->SearchRequest->NotifySearchFinished(false, LOCTEXT("Error_MatchmakingPartyFailed", "Could not create a party for matchmaking"));
+					SearchSettings.Reset();
+				}
+			}));
+
+		if (!bWaitForParty)
+		{
+			StartMatchmaking();
+		}
 	}
 	else
 	// #END	
@@ -990,19 +1624,31 @@ void UCommonSessionSubsystem::QuickPlaySession(APlayerController* JoiningOrHosti
 	UCommonSession_SearchSessionRequest* QuickPlayRequest = CreateOnlineSearchSessionRequest();
 	QuickPlayRequest->OnSearchFinished.AddUObject(this, &UCommonSessionSubsystem::HandleQuickPlaySearchFinished, JoiningOrHostingPlayerPtr, HostRequestPtr);
 
-	FindSessionsInternal(JoiningOrHostingPlayer, CreateQuickPlaySearchSettings(HostRequest, QuickPlayRequest));
+	// A new quick play replaces any race or candidate list that is still running. The old race may still own a
+	// session under the active name, so the new one only starts once the discard has finished.
+	QuickPlayJoin.Reset();
+	DiscardQuickPlayRace([this, JoiningOrHostingPlayerPtr, HostRequestPtr, QuickPlayRequestPtr = TStrongObjectPtr<UCommonSession_SearchSessionRequest>(QuickPlayRequest)]()
+	{
+		APlayerController* Player = JoiningOrHostingPlayerPtr.Get();
+		if (bRaceQuickPlayHost)
+		{
+			PrepareQuickPlayRace(Player, HostRequestPtr.Get(), QuickPlayRequestPtr.Get());
+		}
+
+		FindSessionsInternal(Player, CreateQuickPlaySearchSettings(HostRequestPtr.Get(), QuickPlayRequestPtr.Get()));
+	});
 }
 
 void UCommonSessionSubsystem::StartSession()
 {
 	IOnlineSessionPtr Session = Online::GetSessionInterface();
 	check(Session)
-	FName GameSession = NAME_GameSession;
+	FName GameSession = ActiveSessionName;
 	EOnlineSessionState::Type SessionState = Session->GetSessionState(GameSession);
 	if(SessionState == EOnlineSessionState::Pending)
 	{
 		UE_LOG(LogCommonSession, Log, TEXT("UCommonSessionSubsystem::StartSession: Start session %s"), *GameSession.ToString());
-		Session->StartSession(NAME_GameSession);
+		Session->StartSession(GameSession);
 		return;
 	}
 	UE_LOG(LogCommonSession, Warning, TEXT("UCommonSessionSubsystem::StartSession: Failed to start session, session state is not Pending. Current Session State: %s"), EOnlineSessionState::ToString(SessionState));
@@ -1030,6 +1676,17 @@ void UCommonSessionSubsystem::MatchmakingSession(APlayerController* JoiningOrHos
 
 	OutMatchmakingSessionRequest = CreateOnlineSearchSessionRequest();
 	OutMatchmakingSessionRequest->OnSearchFinished.AddUObject(this, &UCommonSessionSubsystem::HandleMatchmakingFinished, JoiningOrHostingPlayerPtr, HostRequestPtr);
+	MatchmakingSessionName = bMatchmakingNextSession ? GetNextSessionName() : ActiveSessionName;
+
+#if COMMONUSER_OSSV1
+	ClearMatchmakingRetry();
+	MatchmakingRetry = MakeShared<FCommonMatchmakingRetry>();
+	MatchmakingRetry->HostRequest = HostRequestPtr;
+	MatchmakingRetry->SearchRequest = TStrongObjectPtr<UCommonSession_SearchSessionRequest>(OutMatchmakingSessionRequest);
+	MatchmakingRetry->Player = JoiningOrHostingPlayerPtr;
+
+	ResetMatchmakingQueues(HostRequest);
+#endif // COMMONUSER_OSSV1
 	
 	FindSessionsInternal(JoiningOrHostingPlayer, CreateMatchmakingSearchSettings(HostRequest, OutMatchmakingSessionRequest));
 }
@@ -1042,11 +1699,187 @@ void UCommonSessionSubsystem::CancelMatchmakingSession(APlayerController* Cancel
 	check(Sessions);
 
 	SearchSettings.Reset();
+	PendingMatchmakingQueues.Reset();
+	ClearMatchmakingRetry();
+	QuickPlayJoin.Reset();
+	MatchmakingStartTime = 0.0;
+#if COMMONUSER_OSSV1
+	FinishReadyConsent(false);
+#endif // COMMONUSER_OSSV1
 
 	int32 LocalPlayerIndex = CancelPlayer->GetLocalPlayer()->GetLocalPlayerIndex();
-	
-	Sessions->CancelMatchmaking(LocalPlayerIndex, NAME_GameSession);
+#if COMMONUSER_OSSV1
+	ActiveMatchmakingTicket.Reset();
+#endif // COMMONUSER_OSSV1
+	Sessions->CancelMatchmaking(LocalPlayerIndex, MatchmakingSessionName);
+	bMatchmakingNextSession = false;
+}
+
+bool UCommonSessionSubsystem::ConfirmReadyConsent(APlayerController* ConsentingPlayer)
+{
+#if COMMONUSER_OSSV1
+	return SendReadyConsent(ConsentingPlayer ? ConsentingPlayer->GetLocalPlayer() : nullptr);
+#else
+	return false;
+#endif // COMMONUSER_OSSV1
+}
+
+bool UCommonSessionSubsystem::GetEstimatedQueueTime(const FString& Queue, float& OutSeconds, float Percentile) const
+{
+	const FCommonMatchmakingQueueHistogram* Histogram = MatchmakingQueueStats.Find(Queue);
+	const TOptional<float> Estimate = Histogram ? Histogram->GetPercentile(Percentile) : TOptional<float>();
+	OutSeconds = Estimate.Get(0.0f);
+	return Estimate.IsSet();
+}
+
+float UCommonSessionSubsystem::GetMatchmakingElapsedTime() const
+{
+	return MatchmakingStartTime > 0.0 ? static_cast<float>(FPlatformTime::Seconds() - MatchmakingStartTime) : 0.0f;
+}
+
+float UCommonSessionSubsystem::GetMatchmakingWaitPercentile(const FString& Queue) const
+{
+	const FCommonMatchmakingQueueHistogram* Histogram = MatchmakingQueueStats.Find(Queue);
+	return Histogram ? Histogram->GetFractionBelow(GetMatchmakingElapsedTime()) : 0.0f;
+}
+
+#if COMMONUSER_OSSV1
+void UCommonSessionSubsystem::ResetMatchmakingQueues(const UCommonSession_HostSessionRequest* HostRequest)
+{
+	// Alternate queues are only submitted once the queue before them failed or timed out
+	PendingMatchmakingQueues.Reset();
+	for (const FString& Queue : HostRequest->AccelByteAlternateGameModes)
+	{
+		if (!Queue.IsEmpty() && Queue != HostRequest->AccelByteGameMode)
+		{
+			PendingMatchmakingQueues.AddUnique(Queue);
+		}
+	}
+}
+
+bool UCommonSessionSubsystem::StartMatchmakingTicketOSSv1(const TSharedRef<FCommonOnlineSearchSettings>& Search, const FString& Queue)
+{
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	check(Sessions);
+
+	UE_LOG(LogCommonSession, Log, TEXT("Submitting matchmaking ticket (Queue: %s, SessionName: %s)"), *Queue, *MatchmakingSessionName.ToString());
+
+	ActiveMatchmakingTicket = MakeShared<FCommonMatchmakingTicket>(Queue, Search);
+	TSharedRef<FOnlineSessionSearch> SessionSearch = Search;
+	if (!Sessions->StartMatchmaking({MatchmakingUserId.ToSharedRef()}, MatchmakingSessionName, FOnlineSessionSettings(), SessionSearch))
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("Failed to submit matchmaking ticket for queue %s"), *Queue);
+		ActiveMatchmakingTicket.Reset();
+		return false;
+	}
+	return true;
+}
+
+bool UCommonSessionSubsystem::StartNextMatchmakingQueue()
+{
+	while (SearchSettings.IsValid() && PendingMatchmakingQueues.Num() > 0)
+	{
+		const FString Queue = PendingMatchmakingQueues[0];
+		PendingMatchmakingQueues.RemoveAt(0);
+
+		TSharedRef<FCommonOnlineSearchSettingsOSSv1> Search = MakeShared<FCommonOnlineSearchSettingsOSSv1>(SearchSettings->SearchRequest);
+		Search->QuerySettings = SearchSettings->QuerySettings;
+		Search->QuerySettings.Set(SETTING_GAMEMODE, Queue, EOnlineComparisonOp::Equals);
+		Search->QuerySettings.Set(SEARCH_MATCHMAKING_QUEUE, Queue, EOnlineComparisonOp::Equals);
+		if (StartMatchmakingTicketOSSv1(Search, Queue))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UCommonSessionSubsystem::ScheduleMatchmakingRetry()
+{
+	if (!MatchmakingRetry.IsValid() || MatchmakingRetry->Attempt >= MatchmakingMaxAttempts)
+	{
+		return false;
+	}
+
+	// Exponential backoff with jitter so a party that keeps failing does not hammer the matchmaker in lockstep
+	const float BaseDelay = MatchmakingRetryBaseDelay * FMath::Pow(2.0f, static_cast<float>(MatchmakingRetry->Attempt - 1));
+	const float Jitter = FMath::Clamp(MatchmakingRetryJitter, 0.0f, 1.0f);
+	const float Delay = FMath::Min(BaseDelay, MatchmakingRetryMaxDelay) * FMath::FRandRange(1.0f - Jitter, 1.0f + Jitter);
+
+	UE_LOG(LogCommonSession, Log, TEXT("Matchmaking attempt %d failed, retrying in %.1f seconds"), MatchmakingRetry->Attempt, Delay);
+
+	SearchSettings.Reset();
+	ActiveMatchmakingTicket.Reset();
+	OnMatchmakingRetryDelegate.Broadcast(MatchmakingRetry->Attempt + 1, Delay);
+
+	// Leave whatever the failed attempt created before waiting out the backoff
+	CleanUpSessionsAsync(bFastLeaveSessions).Next([WeakThis = TWeakObjectPtr<UCommonSessionSubsystem>(this), WeakRetry = TWeakPtr<FCommonMatchmakingRetry>(MatchmakingRetry), Delay](bool)
+	{
+		UCommonSessionSubsystem* StrongThis = WeakThis.Get();
+		const TSharedPtr<FCommonMatchmakingRetry> Retry = WeakRetry.Pin();
+		if (StrongThis == nullptr || !Retry.IsValid() || Retry != StrongThis->MatchmakingRetry)
+		{
+			// Canceled or replaced by a new request while cleaning up
+			return;
+		}
+
+		StrongThis->GetGameInstance()->GetTimerManager().SetTimer(Retry->RetryTimerHandle,
+			FTimerDelegate::CreateUObject(StrongThis, &UCommonSessionSubsystem::RetryMatchmaking), FMath::Max(Delay, UE_KINDA_SMALL_NUMBER), false);
+	});
+	return true;
+}
+
+void UCommonSessionSubsystem::RetryMatchmaking()
+{
+	if (!MatchmakingRetry.IsValid())
+	{
+		return;
+	}
+
+	const TSharedRef<FCommonMatchmakingRetry> Retry = MatchmakingRetry.ToSharedRef();
+	APlayerController* Player = Retry->Player.Get();
+	if (Player == nullptr || SearchSettings.IsValid())
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("Dropping matchmaking retry, the player left or another search is running"));
+		MatchmakingRetry.Reset();
+		Retry->SearchRequest->NotifySearchFinished(false, LOCTEXT("Error_MatchmakingRetryAborted", "Matchmaking retry aborted"));
+		return;
+	}
+
+	Retry->Attempt++;
+	UE_LOG(LogCommonSession, Log, TEXT("Matchmaking attempt %d of %d"), Retry->Attempt, MatchmakingMaxAttempts);
+
+	ResetMatchmakingQueues(Retry->HostRequest.Get());
+	TSharedRef<FCommonOnlineSearchSettings> Search = CreateMatchmakingSearchSettings(Retry->HostRequest.Get(), Retry->SearchRequest.Get());
+	if (bWidenMatchmakingOnRetry)
+	{
+		WidenMatchmakingSearchSettings(*Search, Retry->Attempt);
+	}
+	FindSessionsInternal(Player, Search);
+}
+
+void UCommonSessionSubsystem::ClearMatchmakingRetry()
+{
+	if (MatchmakingRetry.IsValid())
+	{
+		GetGameInstance()->GetTimerManager().ClearTimer(MatchmakingRetry->RetryTimerHandle);
+		MatchmakingRetry.Reset();
+	}
+}
+
+void UCommonSessionSubsystem::WidenMatchmakingSearchSettings(FCommonOnlineSearchSettings& Search, int32 Attempt) const
+{
+	// Second attempt drops the map tags, later attempts accept any map of the queue
+	for (const FName& Tag : MapCatalogMatchmakingTags)
+	{
+		Search.QuerySettings.SearchParams.Remove(Tag);
+	}
+	if (Attempt > 2)
+	{
+		Search.QuerySettings.SearchParams.Remove(SETTING_MAPNAME);
+	}
 }
+#endif // COMMONUSER_OSSV1
 
 // #END
 
@@ -1104,11 +1937,22 @@ TSharedRef<FCommonOnlineSearchSettings> UCommonSessionSubsystem::CreateMatchmaki
 	MatchmakingSearch->QuerySettings.Set(SETTING_GAMEMODE, Request->AccelByteGameMode, EOnlineComparisonOp::Equals);
 	MatchmakingSearch->QuerySettings.Set(SEARCH_MATCHMAKING_QUEUE, Request->AccelByteGameMode, EOnlineComparisonOp::Equals);
 	MatchmakingSearch->QuerySettings.Set(SEARCH_DEDICATED_ONLY, true, EOnlineComparisonOp::Equals);
-	MatchmakingSearch->QuerySettings.Set(SETTING_MAPNAME, Request->GetMapName(), EOnlineComparisonOp::Equals);
-	FString* NumBots = Request->ExtraArgs.Find(TEXT("NumBots"));
-	if(NumBots != nullptr)
+	if (const FCommonSessionMapCatalogEntry* MapEntry = FindMapCatalogEntry(Request->MapID))
+	{
+		MatchmakingSearch->QuerySettings.Set(SETTING_MAPNAME, MapEntry->PackageName, EOnlineComparisonOp::Equals);
+		for (const TPair<FName, FString>& Tag : MapEntry->MatchmakingTags)
+		{
+			MatchmakingSearch->QuerySettings.Set(Tag.Key, Tag.Value, EOnlineComparisonOp::Equals);
+		}
+	}
+	else
 	{
-		MatchmakingSearch->QuerySettings.Set(SETTING_NUMBOTS, FCString::Atoi(**NumBots), EOnlineComparisonOp::Equals);
+		MatchmakingSearch->QuerySettings.Set(SETTING_MAPNAME, Request->GetMapName(), EOnlineComparisonOp::Equals);
+	}
+	const TOptional<int32> NumBots = Request->GetTravelOptions().GetInt(CommonSessionTravelOption::NumBots);
+	if(NumBots.IsSet())
+	{
+		MatchmakingSearch->QuerySettings.Set(SETTING_NUMBOTS, NumBots.GetValue(), EOnlineComparisonOp::Equals);
 	}
 	return MatchmakingSearch;
 }
@@ -1146,12 +1990,56 @@ void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, con
 		// Join the best search result.
 		if (ResultCount > 0)
 		{
-			//@TODO: We should probably look at ping?  maybe some other factors to find the best.  Idk if they come pre-sorted or not.
+			TSharedRef<FCommonQuickPlayJoin> Join = MakeShared<FCommonQuickPlayJoin>();
+			Join->Player = JoiningOrHostingPlayer;
+			Join->HostRequest = HostRequest;
 			for (UCommonSession_SearchResult* Result : SearchSettings->SearchRequest->Results)
 			{
-				JoinSession(JoiningOrHostingPlayer.Get(), Result);
+				Join->Candidates.Emplace(Result);
+			}
+
+			// Closest sessions first, results with equal ping keep the order the backend returned them in
+			Join->Candidates.StableSort([](const TStrongObjectPtr<UCommonSession_SearchResult>& A, const TStrongObjectPtr<UCommonSession_SearchResult>& B)
+			{
+				return A->GetPingInMs() < B->GetPingInMs();
+			});
+
+			auto StartJoining = [this, Join]()
+			{
+#if COMMONUSER_OSSV1
+				// Resolve the addresses of every candidate quick play may try, a failed join then travels without waiting on a lookup
+				IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+				if (bPreResolveConnectStrings && ConnectCache.IsValid() && Sessions.IsValid())
+				{
+					const int32 NumPrefetch = FMath::Min(QuickPlayMaxJoinAttempts, Join->Candidates.Num());
+					for (int32 Index = 0; Index < NumPrefetch; ++Index)
+					{
+						FString ConnectString;
+						if (Sessions->GetResolvedConnectString(Join->Candidates[Index]->Result, NAME_GamePort, ConnectString))
+						{
+							ConnectCache->Prefetch(ConnectString);
+						}
+					}
+				}
+#endif // COMMONUSER_OSSV1
+
+				QuickPlayJoin = Join;
+				TryNextQuickPlayCandidate();
+			};
+
+			if (QuickPlayRace.IsValid())
+			{
+				// Found a session before the deadline, the prepared host has to go before we can join.
+				// Discarding cleans up the sessions, which drops any candidate list and resolved address, so joining only starts afterwards.
+				DiscardQuickPlayRace(MoveTemp(StartJoining));
 				return;
 			}
+
+			StartJoining();
+		}
+		else if (QuickPlayRace.IsValid())
+		{
+			CommitQuickPlayRace();
 		}
 		else
 		{
@@ -1161,463 +2049,1738 @@ void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, con
 	else
 	{
 		//@TODO: This sucks, need to tell someone.
+		if (QuickPlayRace.IsValid())
+		{
+			DiscardQuickPlayRace([]() {});
+		}
 	}
 }
 
-void UCommonSessionSubsystem::HandleMatchmakingFinished(bool bSucceeded, const FText& ErrorMessage,
-	TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer,
-	TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest)
+void UCommonSessionSubsystem::TryNextQuickPlayCandidate()
 {
-	const int32 ResultCount = SearchSettings->SearchRequest->Results.Num();
-	UE_LOG(LogCommonSession, Log, TEXT("Matchmaking Search Finished %s (Results %d) (Error: %s)"), bSucceeded ? TEXT("Success") : TEXT("Failed"), ResultCount, *ErrorMessage.ToString());
+	if (!QuickPlayJoin.IsValid())
+	{
+		return;
+	}
 
-	if (bSucceeded || ErrorMessage.IsEmpty())
+	if (QuickPlayJoin->Candidates.Num() == 0 || QuickPlayJoin->Attempts >= QuickPlayMaxJoinAttempts)
 	{
-		// Matchmaking found suitable DS.
-		if (ResultCount > 0)
-		{
-			for (UCommonSession_SearchResult* Result : SearchSettings->SearchRequest->Results)
-			{
-				JoinSession(JoiningOrHostingPlayer.Get(), Result);
-				return;
-			}
-		}
+		UE_LOG(LogCommonSession, Log, TEXT("QuickPlay could not join any of its candidates (Attempts: %d), hosting instead"), QuickPlayJoin->Attempts);
+		TSharedPtr<FCommonQuickPlayJoin> Join = MoveTemp(QuickPlayJoin);
+		HostSession(Join->Player.Get(), Join->HostRequest.Get());
+		return;
 	}
 
-	// Fail, cleanup session
-	CleanUpSessions();
-}
+	TStrongObjectPtr<UCommonSession_SearchResult> Candidate = QuickPlayJoin->Candidates[0];
+	QuickPlayJoin->Candidates.RemoveAt(0);
 
-void UCommonSessionSubsystem::CleanUpSessions()
-{
-	bWantToDestroyPendingSession = true;
-	HostSettings.Reset();
 #if COMMONUSER_OSSV1
-	CleanUpSessionsOSSv1();
-#else
-	CleanUpSessionsOSSv2();
+	ULocalPlayer* LocalPlayer = QuickPlayJoin->Player.IsValid() ? QuickPlayJoin->Player->GetLocalPlayer() : nullptr;
+	const FUniqueNetIdPtr UserId = LocalPlayer ? LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId() : nullptr;
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (bRefreshQuickPlayCandidates && UserId.IsValid() && Sessions.IsValid() && Candidate->Result.Session.SessionInfo.IsValid())
+	{
+		// The search result may be stale by now, re-read the open slots before spending a join on it
+		TWeakPtr<FCommonQuickPlayJoin> WeakJoin = QuickPlayJoin;
+		Sessions->FindSessionById(*UserId, Candidate->Result.Session.SessionInfo->GetSessionId(), *UserId,
+			FOnSingleSessionResultCompleteDelegate::CreateWeakLambda(this, [this, WeakJoin, Candidate](int32 LocalUserNum, bool bWasSuccessful, const FOnlineSessionSearchResult& Refreshed)
+			{
+				// A refresh for a quick play that was canceled or replaced meanwhile
+				if (!QuickPlayJoin.IsValid() || WeakJoin.Pin() != QuickPlayJoin)
+				{
+					return;
+				}
+
+				if (bWasSuccessful && Refreshed.IsValid())
+				{
+					Candidate->Result = Refreshed;
+				}
+
+				if (!bWasSuccessful || !Refreshed.IsValid() || Candidate->GetNumOpenPublicConnections() <= 0)
+				{
+					UE_LOG(LogCommonSession, Log, TEXT("QuickPlay candidate is gone or full, skipping it"));
+					TryNextQuickPlayCandidate();
+					return;
+				}
+
+				JoinQuickPlayCandidate(Candidate);
+			}));
+		return;
+	}
 #endif // COMMONUSER_OSSV1
+
+	JoinQuickPlayCandidate(Candidate);
 }
 
-#if COMMONUSER_OSSV1
-void UCommonSessionSubsystem::CleanUpSessionsOSSv1()
+void UCommonSessionSubsystem::JoinQuickPlayCandidate(const TStrongObjectPtr<UCommonSession_SearchResult>& Candidate)
 {
-	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
-	check(OnlineSub);
-	IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
-	check(Sessions);
+	QuickPlayJoin->Attempts++;
+	QuickPlayJoin->JoiningCandidate = Candidate;
 
-	EOnlineSessionState::Type SessionState = Sessions->GetSessionState(NAME_GameSession);
-	UE_LOG(LogCommonSession, Log, TEXT("Session state is %s"), EOnlineSessionState::ToString(SessionState));
+	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay joining candidate %d/%d (%s)"), QuickPlayJoin->Attempts, QuickPlayMaxJoinAttempts, *Candidate->GetDescription());
+	JoinSession(QuickPlayJoin->Player.Get(), Candidate.Get());
+}
 
-	if (EOnlineSessionState::InProgress == SessionState)
+bool UCommonSessionSubsystem::HandleQuickPlayJoinFinished(bool bWasSuccessful, bool bCanTryNext)
+{
+	if (!QuickPlayJoin.IsValid() || !QuickPlayJoin->JoiningCandidate.IsValid())
 	{
-		UE_LOG(LogCommonSession, Log, TEXT("Ending session because of return to front end"));
-		Sessions->EndSession(NAME_GameSession);
+		return false;
 	}
-	else if (EOnlineSessionState::Ending == SessionState)
+	QuickPlayJoin->JoiningCandidate.Reset();
+
+	if (bWasSuccessful || !bCanTryNext)
 	{
-		UE_LOG(LogCommonSession, Log, TEXT("Waiting for session to end on return to main menu"));
+		QuickPlayJoin.Reset();
+		return false;
 	}
-	else if (EOnlineSessionState::Ended == SessionState || EOnlineSessionState::Pending == SessionState)
+
+	TryNextQuickPlayCandidate();
+	return true;
+}
+
+bool UCommonSessionSubsystem::PrepareQuickPlayRace(APlayerController* Player, UCommonSession_HostSessionRequest* HostRequest, UCommonSession_SearchSessionRequest* SearchRequest)
+{
+	// Requests that cannot be hosted fall back to the sequential flow so HostSession reports them as before
+	ULocalPlayer* LocalPlayer = (Player != nullptr) ? Player->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr || HostRequest->OnlineMode == ECommonSessionOnlineMode::Offline || !HostRequest->ValidateAndLogErrors())
 	{
-		UE_LOG(LogCommonSession, Log, TEXT("Destroying session on return to main menu"));
-		Sessions->DestroySession(NAME_GameSession);
+		return false;
 	}
-	else if (EOnlineSessionState::Starting == SessionState || EOnlineSessionState::Creating == SessionState)
+
+	if (HostRequest->GetMapName().IsEmpty())
 	{
-		UE_LOG(LogCommonSession, Log, TEXT("Waiting for session to start, and then we will end it to return to main menu"));
+		UE_LOG(LogCommonSession, Warning, TEXT("QuickPlay race skipped, map %s could not be resolved"), *HostRequest->MapID.ToString());
+		return false;
 	}
-	else
+
+	QuickPlayRace = MakeShared<FCommonQuickPlayRace>();
+	QuickPlayRace->Player = Player;
+	QuickPlayRace->HostRequest = TStrongObjectPtr<UCommonSession_HostSessionRequest>(HostRequest);
+	QuickPlayRace->SearchRequest = SearchRequest;
+
+	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay racing host against search (Deadline: %.2fs)"), QuickPlayRaceDeadline);
+	GetGameInstance()->GetTimerManager().SetTimer(QuickPlayRace->DeadlineTimerHandle,
+		FTimerDelegate::CreateUObject(this, &ThisClass::HandleQuickPlayRaceDeadline), FMath::Max(QuickPlayRaceDeadline, 0.01f), false);
+
+#if COMMONUSER_OSSV1
+	if (bPreCreateQuickPlayHostSession)
 	{
-		// reset if fail to cleanup session
-		bWantToDestroyPendingSession = false;
+		QuickPlayRace->bPreCreating = true;
+		CreateOnlineSessionInternal(LocalPlayer, HostRequest);
 	}
+#endif // COMMONUSER_OSSV1
+
+	return true;
 }
 
-#else
-void UCommonSessionSubsystem::CleanUpSessionsOSSv2()
+void UCommonSessionSubsystem::SettleQuickPlayRace()
 {
-	IOnlineServicesPtr OnlineServices = GetServices(GetWorld());
-	check(OnlineServices);
-	ILobbiesPtr Lobbies = OnlineServices->GetLobbiesInterface();
-	check(Lobbies);
+	if (!QuickPlayRace.IsValid())
+	{
+		return;
+	}
 
-	FOnlineAccountIdHandle LocalPlayerId = GetAccountId(GetGameInstance()->GetFirstLocalPlayerController());
-	FOnlineLobbyIdHandle LobbyId = GetLobbyId(NAME_GameSession);
+	GetGameInstance()->GetTimerManager().ClearTimer(QuickPlayRace->DeadlineTimerHandle);
+	if (UCommonSession_SearchSessionRequest* SearchRequest = QuickPlayRace->SearchRequest.Get())
+	{
+		SearchRequest->OnSearchFinished.RemoveAll(this);
+	}
+}
 
-	if (!LocalPlayerId.IsValid() || !LobbyId.IsValid())
+void UCommonSessionSubsystem::CommitQuickPlayRace()
+{
+	SettleQuickPlayRace();
+
+	TSharedPtr<FCommonQuickPlayRace> Race = QuickPlayRace;
+	if (!Race.IsValid())
 	{
 		return;
 	}
-	// TODO:  Include all local players leave the lobby
-	Lobbies->LeaveLobby({LocalPlayerId, LobbyId});
-}
 
-#endif // COMMONUSER_OSSV1
+	if (Race->bPreCreating)
+	{
+		// Finished by HandleQuickPlayRaceSessionCreated
+		Race->bCommitted = true;
+		return;
+	}
+
+	QuickPlayRace.Reset();
+	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay race committing to host (PreCreated: %d)"), Race->bPreCreated);
 
 #if COMMONUSER_OSSV1
-void UCommonSessionSubsystem::OnFindSessionsComplete(bool bWasSuccessful)
+	if (Race->bPreCreated)
+	{
+		IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+		const FOnlineSessionSettings* CurrentSettings = Sessions.IsValid() ? Sessions->GetSessionSettings(ActiveSessionName) : nullptr;
+		if (CurrentSettings != nullptr)
+		{
+			FOnlineSessionSettings UpdatedSettings = *CurrentSettings;
+			UpdatedSettings.bShouldAdvertise = true;
+			if (HostSettings.IsValid())
+			{
+				HostSettings->bShouldAdvertise = true;
+			}
+			Sessions->UpdateSession(ActiveSessionName, UpdatedSettings, true);
+
+			OnSessionCreatedDelegate.Broadcast();
+			FinishSessionCreation(true);
+			return;
+		}
+
+		UE_LOG(LogCommonSession, Warning, TEXT("QuickPlay race lost its pre-created session, hosting a new one"));
+	}
+#endif // COMMONUSER_OSSV1
+
+	HostSession(Race->Player.Get(), Race->HostRequest.Get());
+}
+
+void UCommonSessionSubsystem::DiscardQuickPlayRace(TFunction<void()>&& Then)
 {
-	UE_LOG(LogCommonSession, Log, TEXT("OnFindSessionsComplete(bWasSuccessful: %s)"), bWasSuccessful ? TEXT("true") : TEXT("false"));
+	SettleQuickPlayRace();
 
-	if (!SearchSettings.IsValid())
+	TSharedPtr<FCommonQuickPlayRace> Race = QuickPlayRace;
+	if (!Race.IsValid())
 	{
-		// This could get called twice for failed session searches, or for a search requested by a different system
+		Then();
 		return;
 	}
 
-	FCommonOnlineSearchSettingsOSSv1& SearchSettingsV1 = *StaticCastSharedPtr<FCommonOnlineSearchSettingsOSSv1>(SearchSettings);
-	if (SearchSettingsV1.SearchState == EOnlineAsyncTaskState::InProgress)
+	if (Race->bPreCreating)
 	{
-		UE_LOG(LogCommonSession, Error, TEXT("OnFindSessionsComplete called when search is still in progress!"));
+		// Finished by HandleQuickPlayRaceSessionCreated
+		Race->bDiscarded = true;
+		Race->OnDiscarded = MoveTemp(Then);
 		return;
 	}
 
-	if (!ensure(SearchSettingsV1.SearchRequest))
+	QuickPlayRace.Reset();
+	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay race discarding prepared host (PreCreated: %d)"), Race->bPreCreated);
+
+	if (Race->bPreCreated)
 	{
-		UE_LOG(LogCommonSession, Error, TEXT("OnFindSessionsComplete called with invalid search request object!"));
+		CleanUpSessionsAsync(true).Next([WeakThis = TWeakObjectPtr<UCommonSessionSubsystem>(this), Then = MoveTemp(Then)](bool)
+		{
+			if (WeakThis.IsValid())
+			{
+				Then();
+			}
+		});
+	}
+	else
+	{
+		Then();
+	}
+}
+
+void UCommonSessionSubsystem::HandleQuickPlayRaceDeadline()
+{
+	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay race deadline reached without a joinable session"));
+	CommitQuickPlayRace();
+}
+
+void UCommonSessionSubsystem::HandleQuickPlayRaceSessionCreated(bool bWasSuccessful)
+{
+	QuickPlayRace->bPreCreating = false;
+	QuickPlayRace->bPreCreated = bWasSuccessful;
+
+	if (QuickPlayRace->bDiscarded)
+	{
+		TFunction<void()> OnDiscarded = MoveTemp(QuickPlayRace->OnDiscarded);
+		DiscardQuickPlayRace(MoveTemp(OnDiscarded));
+	}
+	else if (QuickPlayRace->bCommitted)
+	{
+		CommitQuickPlayRace();
+	}
+	// Otherwise the session is held until the search or the deadline decides
+}
+
+void UCommonSessionSubsystem::HandleMatchmakingFinished(bool bSucceeded, const FText& ErrorMessage,
+	TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer,
+	TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest)
+{
+	const int32 ResultCount = SearchSettings->SearchRequest->Results.Num();
+	UE_LOG(LogCommonSession, Log, TEXT("Matchmaking Search Finished %s (Results %d) (Error: %s)"), bSucceeded ? TEXT("Success") : TEXT("Failed"), ResultCount, *ErrorMessage.ToString());
+
+	const bool bForNextSession = bMatchmakingNextSession;
+	bMatchmakingNextSession = false;
+
+	if (bSucceeded || ErrorMessage.IsEmpty())
+	{
+		// Matchmaking found suitable DS.
+		if (ResultCount > 0)
+		{
+			for (UCommonSession_SearchResult* Result : SearchSettings->SearchRequest->Results)
+			{
+				if (bForNextSession)
+				{
+					PreJoinNextSession(JoiningOrHostingPlayer.Get(), Result);
+					return;
+				}
+
+#if COMMONUSER_OSSV1
+				// The fast follow join may already have finished by the time our own result arrives
+				const FString SessionId = Result->Result.GetSessionIdStr();
+				IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+				const FNamedOnlineSession* ActiveSession = Sessions.IsValid() ? Sessions->GetNamedSession(ActiveSessionName) : nullptr;
+				if ((!FastFollowSessionId.IsEmpty() && FastFollowSessionId == SessionId)
+					|| (ActiveSession && ActiveSession->SessionInfo.IsValid() && ActiveSession->GetSessionIdStr() == SessionId))
+				{
+					UE_LOG(LogCommonSession, Log, TEXT("Matchmaking result %s is already joined or being joined through a fast follow"), *SessionId);
+					return;
+				}
+
+				FString ConnectString;
+				if (Sessions.IsValid())
+				{
+					Sessions->GetResolvedConnectString(Result->Result, NAME_GamePort, ConnectString);
+				}
+				OnMatchmakingSessionChosenDelegate.Broadcast(SessionId, ConnectString);
+#endif // COMMONUSER_OSSV1
+
+				JoinSession(JoiningOrHostingPlayer.Get(), Result);
+				return;
+			}
+		}
+	}
+
+	if (bForNextSession)
+	{
+		// The active session is still being played, only the next match failed
+		OnNextSessionReadyDelegate.Broadcast(false);
 		return;
 	}
 
-	if (bWasSuccessful)
+	// Fail, cleanup session
+	CleanUpSessions();
+}
+
+void UCommonSessionSubsystem::CleanUpSessions()
+{
+	CleanUpSessionsAsync(bFastLeaveSessions);
+}
+
+TFuture<bool> UCommonSessionSubsystem::CleanUpSessionsAsync(bool bFastLeave)
+{
+	HostSettings.Reset();
+	GetGameInstance()->GetTimerManager().ClearTimer(HostSettingsUpdateTimerHandle);
+	QuickPlayJoin.Reset();
+
+	// Addresses resolved for this game may be stale by the next one
+	if (ConnectCache.IsValid())
 	{
-		SearchSettingsV1.SearchRequest->Results.Reset(SearchSettingsV1.SearchResults.Num());
+		ConnectCache->Reset();
+	}
 
-		for (const FOnlineSessionSearchResult& Result : SearchSettingsV1.SearchResults)
+	// Leaving the game also drops a next match that was lined up
+	LeaveNextSession();
+
+	return TearDownSessionAsync(ActiveSessionName, bFastLeave);
+}
+
+TFuture<bool> UCommonSessionSubsystem::TearDownSessionAsync(FName SessionName, bool bFastLeave)
+{
+	if (ActiveTeardown.IsValid() && ActiveTeardown->SessionName != SessionName)
+	{
+		// One teardown runs at a time, this one starts once the running one is done
+		TSharedRef<TPromise<bool>> Promise = MakeShared<TPromise<bool>>();
+		ActiveTeardown->Waiters.Emplace_GetRef().GetFuture().Next([WeakThis = TWeakObjectPtr<UCommonSessionSubsystem>(this), SessionName, bFastLeave, Promise](bool)
 		{
-			UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(SearchSettingsV1.SearchRequest);
-			Entry->Result = Result;
-			SearchSettingsV1.SearchRequest->Results.Add(Entry);
-			FString OwningUserId = TEXT("Unknown");
-			if (Result.Session.OwningUserId.IsValid())
+			if (!WeakThis.IsValid())
 			{
-				OwningUserId = Result.Session.OwningUserId->ToString();
+				Promise->SetValue(false);
+				return;
 			}
+			WeakThis->TearDownSessionAsync(SessionName, bFastLeave).Next([Promise](bool bWasSuccessful)
+			{
+				Promise->SetValue(bWasSuccessful);
+			});
+		});
+		return Promise->GetFuture();
+	}
 
-			UE_LOG(LogCommonSession, Log, TEXT("\tFound session (UserId: %s, UserName: %s, NumOpenPrivConns: %d, NumOpenPubConns: %d, Ping: %d ms"),
-				*OwningUserId,
-				*Result.Session.OwningUserName,
-				Result.Session.NumOpenPrivateConnections,
-				Result.Session.NumOpenPublicConnections,
-				Result.PingInMs
-				);
-		}
+	if (ActiveTeardown.IsValid())
+	{
+		// Piggyback on the running teardown, but let a fast leave request shortcut it
+		ActiveTeardown->bFastLeave |= bFastLeave;
+		TFuture<bool> Future = ActiveTeardown->Waiters.Emplace_GetRef().GetFuture();
+#if COMMONUSER_OSSV1
+		AdvanceTeardownOSSv1();
+#endif // COMMONUSER_OSSV1
+		return Future;
+	}
+
+	// A pending start only needs to be canceled for the session being played
+	bWantToDestroyPendingSession = SessionName == ActiveSessionName;
+	ActiveTeardown = MakeShared<FCommonSessionTeardown>(SessionName, bFastLeave);
+	TFuture<bool> Future = ActiveTeardown->Waiters.Emplace_GetRef().GetFuture();
+
+#if COMMONUSER_OSSV1
+	CleanUpSessionsOSSv1();
+#else
+	CleanUpSessionsOSSv2();
+#endif // COMMONUSER_OSSV1
+	return Future;
+}
+
+bool UCommonSessionSubsystem::BeginTeardownStep(ECommonSessionTeardownStep Step)
+{
+	check(ActiveTeardown.IsValid());
+
+	if (ActiveTeardown->Step == Step)
+	{
+		ActiveTeardown->StepAttempts++;
 	}
 	else
 	{
-		SearchSettingsV1.SearchRequest->Results.Empty();
+		ActiveTeardown->Step = Step;
+		ActiveTeardown->StepAttempts = 1;
 	}
 
-	if (0)
+	if (ActiveTeardown->StepAttempts > TeardownStepMaxRetries + 1)
 	{
-		// Fake Sessions OSSV1
-		for (int i = 0; i < 10; i++)
+		UE_LOG(LogCommonSession, Warning, TEXT("Session teardown step %d for %s ran out of retries"), (int32)Step, *ActiveTeardown->SessionName.ToString());
+		return false;
+	}
+
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	TimerManager.SetTimer(ActiveTeardown->StepTimeoutHandle, FTimerDelegate::CreateUObject(this, &ThisClass::HandleTeardownStepTimeout), FMath::Max(TeardownStepTimeout, 0.1f), false);
+	return true;
+}
+
+void UCommonSessionSubsystem::HandleTeardownStepTimeout()
+{
+	if (!ActiveTeardown.IsValid())
+	{
+		return;
+	}
+
+	UE_LOG(LogCommonSession, Warning, TEXT("Session teardown step %d for %s timed out (attempt %d)"), (int32)ActiveTeardown->Step, *ActiveTeardown->SessionName.ToString(), ActiveTeardown->StepAttempts);
+
+#if COMMONUSER_OSSV1
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	FNamedOnlineSession* Session = Sessions.IsValid() ? Sessions->GetNamedSession(ActiveTeardown->SessionName) : nullptr;
+	if (Session && Session->SessionState == EOnlineSessionState::Ending)
+	{
+		// Same hang as a failed EndSession, retry it from InProgress
+		Session->SessionState = EOnlineSessionState::InProgress;
+	}
+	AdvanceTeardownOSSv1();
+#else
+	FinishTeardown(false);
+#endif // COMMONUSER_OSSV1
+}
+
+void UCommonSessionSubsystem::FinishTeardown(bool bWasSuccessful)
+{
+	if (!ActiveTeardown.IsValid())
+	{
+		return;
+	}
+
+	// Reset before notifying so waiters can start a new teardown from their callbacks
+	TSharedPtr<FCommonSessionTeardown> Teardown = MoveTemp(ActiveTeardown);
+	bWantToDestroyPendingSession = false;
+
+	if (UGameInstance* GameInstance = GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearTimer(Teardown->StepTimeoutHandle);
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("Session teardown for %s finished (bWasSuccessful: %s)"), *Teardown->SessionName.ToString(), bWasSuccessful ? TEXT("true") : TEXT("false"));
+
+	for (TPromise<bool>& Waiter : Teardown->Waiters)
+	{
+		Waiter.SetValue(bWasSuccessful);
+	}
+}
+
+#if COMMONUSER_OSSV1
+void UCommonSessionSubsystem::CleanUpSessionsOSSv1()
+{
+	AdvanceTeardownOSSv1();
+}
+
+bool UCommonSessionSubsystem::CanDestroySessionDirectly(const FNamedOnlineSession& Session) const
+{
+	// Clients only leave the game session, ending it is the responsibility of the host
+	return !Session.bHosting;
+}
+
+void UCommonSessionSubsystem::AdvanceTeardownOSSv1()
+{
+	if (!ActiveTeardown.IsValid())
+	{
+		return;
+	}
+
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
+	check(OnlineSub);
+	IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
+	check(Sessions);
+
+	const FName SessionName = ActiveTeardown->SessionName;
+	const FNamedOnlineSession* Session = Sessions->GetNamedSession(SessionName);
+	EOnlineSessionState::Type SessionState = Sessions->GetSessionState(SessionName);
+	UE_LOG(LogCommonSession, Log, TEXT("Session state is %s"), EOnlineSessionState::ToString(SessionState));
+
+	if (EOnlineSessionState::InProgress == SessionState && !(ActiveTeardown->bFastLeave && Session && CanDestroySessionDirectly(*Session)))
+	{
+		UE_LOG(LogCommonSession, Log, TEXT("Ending session because of return to front end"));
+		if (BeginTeardownStep(ECommonSessionTeardownStep::Ending))
 		{
-			UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(SearchSettings->SearchRequest);
-			FOnlineSessionSearchResult FakeResult;
-			FakeResult.Session.OwningUserName = TEXT("Fake User");
-			FakeResult.Session.SessionSettings.NumPublicConnections = 10;
-			FakeResult.Session.SessionSettings.bShouldAdvertise = true;
-			FakeResult.Session.SessionSettings.bAllowJoinInProgress = true;
-			FakeResult.PingInMs=99;
-			Entry->Result = FakeResult;
-			SearchSettingsV1.SearchRequest->Results.Add(Entry);
+			Sessions->EndSession(SessionName);
+		}
+		else if (BeginTeardownStep(ECommonSessionTeardownStep::Destroying))
+		{
+			// Ending keeps failing, the session can still be destroyed without it
+			Sessions->DestroySession(SessionName);
+		}
+		else
+		{
+			FinishTeardown(false);
+		}
+	}
+	else if (EOnlineSessionState::Ending == SessionState
+		|| EOnlineSessionState::Starting == SessionState
+		|| EOnlineSessionState::Creating == SessionState
+		|| EOnlineSessionState::Destroying == SessionState)
+	{
+		UE_LOG(LogCommonSession, Log, TEXT("Waiting for session to leave state %s before continuing the teardown"), EOnlineSessionState::ToString(SessionState));
+		if (!BeginTeardownStep(ECommonSessionTeardownStep::Waiting))
+		{
+			FinishTeardown(false);
+		}
+	}
+	else if (EOnlineSessionState::Ended == SessionState || EOnlineSessionState::Pending == SessionState || EOnlineSessionState::InProgress == SessionState)
+	{
+		UE_LOG(LogCommonSession, Log, TEXT("Destroying session on return to main menu"));
+		if (BeginTeardownStep(ECommonSessionTeardownStep::Destroying))
+		{
+			Sessions->DestroySession(SessionName);
+		}
+		else
+		{
+			FinishTeardown(false);
+		}
+	}
+	else if (EOnlineSessionState::NoSession == SessionState)
+	{
+		FinishTeardown(true);
+	}
+	else
+	{
+		// reset if fail to cleanup session
+		FinishTeardown(false);
+	}
+}
+
+#else
+void UCommonSessionSubsystem::CleanUpSessionsOSSv2()
+{
+	IOnlineServicesPtr OnlineServices = GetServices(GetWorld());
+	check(OnlineServices);
+	ILobbiesPtr Lobbies = OnlineServices->GetLobbiesInterface();
+	check(Lobbies);
+
+	FOnlineAccountIdHandle LocalPlayerId = GetAccountId(GetGameInstance()->GetFirstLocalPlayerController());
+	const FName SessionName = ActiveTeardown->SessionName;
+	FOnlineLobbyIdHandle LobbyId = GetLobbyId(SessionName);
+
+	if (!LocalPlayerId.IsValid() || !LobbyId.IsValid())
+	{
+		FinishTeardown(!LobbyId.IsValid());
+		return;
+	}
+
+	BeginTeardownStep(ECommonSessionTeardownStep::Destroying);
+
+	// TODO:  Include all local players leave the lobby
+	Lobbies->LeaveLobby({LocalPlayerId, LobbyId}).OnComplete(this, [this, SessionName, WeakTeardown = TWeakPtr<FCommonSessionTeardown>(ActiveTeardown)](const TOnlineResult<FLeaveLobby>& LeaveResult)
+	{
+		if (LeaveResult.IsOk())
+		{
+			JoinedLobbies.Remove(SessionName);
+		}
+
+		// A step timeout may have finished this teardown already, a newer one must not get this lobby's result
+		if (WeakTeardown.IsValid() && WeakTeardown.Pin() == ActiveTeardown)
+		{
+			FinishTeardown(LeaveResult.IsOk());
+		}
+	});
+}
+
+#endif // COMMONUSER_OSSV1
+
+#if COMMONUSER_OSSV1
+void UCommonSessionSubsystem::OnFindSessionsComplete(bool bWasSuccessful)
+{
+	UE_LOG(LogCommonSession, Log, TEXT("OnFindSessionsComplete(bWasSuccessful: %s)"), bWasSuccessful ? TEXT("true") : TEXT("false"));
+
+	if (!SearchSettings.IsValid())
+	{
+		// This could get called twice for failed session searches, or for a search requested by a different system
+		return;
+	}
+
+	FCommonOnlineSearchSettingsOSSv1& SearchSettingsV1 = *StaticCastSharedPtr<FCommonOnlineSearchSettingsOSSv1>(SearchSettings);
+	if (SearchSettingsV1.SearchState == EOnlineAsyncTaskState::InProgress)
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("OnFindSessionsComplete called when search is still in progress!"));
+		return;
+	}
+
+	if (!ensure(SearchSettingsV1.SearchRequest))
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("OnFindSessionsComplete called with invalid search request object!"));
+		return;
+	}
+
+	if (bWasSuccessful)
+	{
+		SearchSettingsV1.SearchRequest->Results.Reset(SearchSettingsV1.SearchResults.Num());
+
+		for (const FOnlineSessionSearchResult& Result : SearchSettingsV1.SearchResults)
+		{
+			FString OwningUserId = TEXT("Unknown");
+			if (Result.Session.OwningUserId.IsValid())
+			{
+				OwningUserId = Result.Session.OwningUserId->ToString();
+			}
+
+			if (IsSearchResultBlocked(Result))
+			{
+				UE_LOG(LogCommonSession, Verbose, TEXT("\tIgnoring session owned by a blocked player (UserId: %s)"), *OwningUserId);
+				continue;
+			}
+
+			UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(SearchSettingsV1.SearchRequest);
+			Entry->Result = Result;
+			SearchSettingsV1.SearchRequest->Results.Add(Entry);
+
+			UE_LOG(LogCommonSession, Log, TEXT("\tFound session (UserId: %s, UserName: %s, NumOpenPrivConns: %d, NumOpenPubConns: %d, Ping: %d ms"),
+				*OwningUserId,
+				*Result.Session.OwningUserName,
+				Result.Session.NumOpenPrivateConnections,
+				Result.Session.NumOpenPublicConnections,
+				Result.PingInMs
+				);
+		}
+	}
+	else
+	{
+		SearchSettingsV1.SearchRequest->Results.Empty();
+	}
+
+	if (0)
+	{
+		// Fake Sessions OSSV1
+		for (int i = 0; i < 10; i++)
+		{
+			UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(SearchSettings->SearchRequest);
+			FOnlineSessionSearchResult FakeResult;
+			FakeResult.Session.OwningUserName = TEXT("Fake User");
+			FakeResult.Session.SessionSettings.NumPublicConnections = 10;
+			FakeResult.Session.SessionSettings.bShouldAdvertise = true;
+			FakeResult.Session.SessionSettings.bAllowJoinInProgress = true;
+			FakeResult.PingInMs=99;
+			Entry->Result = FakeResult;
+			SearchSettingsV1.SearchRequest->Results.Add(Entry);
+		}
+	}
+	
+	SearchSettingsV1.SearchRequest->NotifySearchFinished(bWasSuccessful, bWasSuccessful ? FText() : LOCTEXT("Error_FindSessionV1Failed", "Find session failed"));
+	SearchSettings.Reset();
+}
+
+bool UCommonSessionSubsystem::IsSearchResultBlocked(const FOnlineSessionSearchResult& Result) const
+{
+	if (BlockedAccelByteIds.Num() == 0 || !Result.Session.OwningUserId.IsValid())
+	{
+		return false;
+	}
+
+	const TSharedRef<const FUniqueNetIdAccelByteUser> ABUser = FUniqueNetIdAccelByteUser::Cast(*Result.Session.OwningUserId);
+	return BlockedAccelByteIds.Contains(ABUser->GetAccelByteId());
+}
+
+int32 UCommonSessionSubsystem::GetBlockedListOwnerIndex() const
+{
+	const ULocalPlayer* LocalPlayer = GetGameInstance()->GetFirstGamePlayer();
+	return LocalPlayer ? LocalPlayer->GetLocalPlayerIndex() : INDEX_NONE;
+}
+
+void UCommonSessionSubsystem::HandleQueryBlockedPlayersComplete(const FUniqueNetId& UserId, bool bWasSuccessful, const FString& Error)
+{
+	// The notification is shared by every local user, searches are filtered with the primary player's list only
+	const ULocalPlayer* LocalPlayer = GetGameInstance()->GetFirstGamePlayer();
+	const FUniqueNetIdPtr OwnerId = LocalPlayer ? LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId() : nullptr;
+	if (!OwnerId.IsValid() || *OwnerId != UserId)
+	{
+		return;
+	}
+
+	if (!bWasSuccessful)
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("HandleQueryBlockedPlayersComplete: query failed, keeping %d blocked ids (%s)"), BlockedAccelByteIds.Num(), *Error);
+		return;
+	}
+
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
+	const IOnlineFriendsPtr FriendsInterface = OnlineSub ? OnlineSub->GetFriendsInterface() : nullptr;
+	if (!FriendsInterface.IsValid())
+	{
+		return;
+	}
+
+	TArray<TSharedRef<FOnlineBlockedPlayer>> BlockedPlayers;
+	FriendsInterface->GetBlockedPlayers(UserId, BlockedPlayers);
+
+	BlockedAccelByteIds.Reset();
+	BlockedAccelByteIds.Reserve(BlockedPlayers.Num());
+	for (const TSharedRef<FOnlineBlockedPlayer>& BlockedPlayer : BlockedPlayers)
+	{
+		BlockedAccelByteIds.Add(FUniqueNetIdAccelByteUser::Cast(*BlockedPlayer->GetUserId())->GetAccelByteId());
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("HandleQueryBlockedPlayersComplete: %d blocked players"), BlockedAccelByteIds.Num());
+}
+
+void UCommonSessionSubsystem::HandleBlockedPlayerComplete(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UniqueId, const FString& ListName, const FString& Error)
+{
+	if (bWasSuccessful && LocalUserNum == GetBlockedListOwnerIndex())
+	{
+		BlockedAccelByteIds.Add(FUniqueNetIdAccelByteUser::Cast(UniqueId)->GetAccelByteId());
+	}
+}
+
+void UCommonSessionSubsystem::HandleUnblockedPlayerComplete(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UniqueId, const FString& ListName, const FString& Error)
+{
+	if (bWasSuccessful && LocalUserNum == GetBlockedListOwnerIndex())
+	{
+		BlockedAccelByteIds.Remove(FUniqueNetIdAccelByteUser::Cast(UniqueId)->GetAccelByteId());
+	}
+}
+
+void UCommonSessionSubsystem::HandleBlockedListOwnerLoginStatusChanged(int32 LocalUserNum, ELoginStatus::Type OldStatus, ELoginStatus::Type NewStatus, const FUniqueNetId& NewId)
+{
+	// The next account on this machine must not inherit the previous user's filter, it is filled again by its own blocked list query
+	if (LocalUserNum == GetBlockedListOwnerIndex() && (NewStatus != ELoginStatus::LoggedIn || OldStatus != ELoginStatus::LoggedIn))
+	{
+		BlockedAccelByteIds.Reset();
+	}
+}
+#endif // COMMONUSER_OSSV1
+
+
+void UCommonSessionSubsystem::JoinSession(APlayerController* JoiningPlayer, UCommonSession_SearchResult* Request)
+{
+	if (Request == nullptr)
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("JoinSession passed a null request"));
+		return;
+	}
+
+	ULocalPlayer* LocalPlayer = (JoiningPlayer != nullptr) ? JoiningPlayer->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr)
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("JoiningPlayer is invalid"));
+		return;
+	}
+
+	// Joining anything but the candidate quick play is trying abandons the quick play
+	if (QuickPlayJoin.IsValid() && QuickPlayJoin->JoiningCandidate.Get() != Request)
+	{
+		QuickPlayJoin.Reset();
+	}
+
+	JoinSessionInternal(LocalPlayer, Request, ActiveSessionName);
+}
+
+void UCommonSessionSubsystem::JoinSessionInternal(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request, FName SessionName)
+{
+#if COMMONUSER_OSSV1
+	JoinSessionInternalOSSv1(LocalPlayer, Request, SessionName);
+#else
+	JoinSessionInternalOSSv2(LocalPlayer, Request, SessionName);
+#endif // COMMONUSER_OSSV1
+}
+
+FName UCommonSessionSubsystem::GetNextSessionName() const
+{
+	static const FName NAME_NextGameSession(TEXT("NextGameSession"));
+	return ActiveSessionName == NAME_GameSession ? NAME_NextGameSession : NAME_GameSession;
+}
+
+void UCommonSessionSubsystem::FastFollowSession(APlayerController* JoiningPlayer, const FString& SessionId, const FString& ConnectString)
+{
+#if COMMONUSER_OSSV1
+	ULocalPlayer* LocalPlayer = (JoiningPlayer != nullptr) ? JoiningPlayer->GetLocalPlayer() : nullptr;
+	const FUniqueNetIdPtr UserId = LocalPlayer ? LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId() : nullptr;
+	if (!UserId.IsValid() || SessionId.IsEmpty())
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("FastFollowSession passed an invalid player or session"));
+		return;
+	}
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	check(Sessions.IsValid());
+
+	const FNamedOnlineSession* ActiveSession = Sessions->GetNamedSession(ActiveSessionName);
+	if (FastFollowSessionId == SessionId || (ActiveSession && ActiveSession->SessionInfo.IsValid() && ActiveSession->GetSessionIdStr() == SessionId))
+	{
+		return;
+	}
+
+	const FUniqueNetIdPtr SessionUniqueId = Sessions->CreateSessionIdFromString(SessionId);
+	if (!SessionUniqueId.IsValid())
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("FastFollowSession could not parse session id %s"), *SessionId);
+		return;
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("Fast following session %s"), *SessionId);
+	FastFollowSessionId = SessionId;
+	bFastFollowTraveled = false;
+
+	if (bFastFollowTravelBeforeJoin && !ConnectString.IsEmpty())
+	{
+		// The server address is already known, the session join does not need to finish before we connect
+		bFastFollowTraveled = true;
+		TravelToConnectString(JoiningPlayer, bPreResolveConnectStrings && ConnectCache.IsValid() ? ConnectCache->Apply(ConnectString) : ConnectString);
+	}
+	else if (bPreResolveConnectStrings && ConnectCache.IsValid() && !ConnectString.IsEmpty())
+	{
+		ConnectCache->Prefetch(ConnectString);
+	}
+
+	TWeakObjectPtr<ULocalPlayer> WeakLocalPlayer(LocalPlayer);
+	Sessions->FindSessionById(*UserId, *SessionUniqueId, *UserId,
+		FOnSingleSessionResultCompleteDelegate::CreateWeakLambda(this, [this, WeakLocalPlayer, SessionId](int32 LocalUserNum, bool bWasSuccessful, const FOnlineSessionSearchResult& Found)
+		{
+			if (FastFollowSessionId != SessionId)
+			{
+				return;
+			}
+
+			if (!bWasSuccessful || !Found.IsValid() || !WeakLocalPlayer.IsValid())
+			{
+				UE_LOG(LogCommonSession, Warning, TEXT("Fast follow could not find session %s"), *SessionId);
+				FastFollowSessionId.Reset();
+				return;
+			}
+
+			UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(this);
+			Entry->Result = Found;
+			JoinSessionInternal(WeakLocalPlayer.Get(), Entry, ActiveSessionName);
+		}));
+#else
+	UE_LOG(LogCommonSession, Warning, TEXT("FastFollowSession is only supported with OSSv1"));
+#endif // COMMONUSER_OSSV1
+}
+
+void UCommonSessionSubsystem::PreJoinNextSession(APlayerController* JoiningPlayer, UCommonSession_SearchResult* Request)
+{
+	if (Request == nullptr)
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("PreJoinNextSession passed a null request"));
+		return;
+	}
+
+	ULocalPlayer* LocalPlayer = (JoiningPlayer != nullptr) ? JoiningPlayer->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr)
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("JoiningPlayer is invalid"));
+		return;
+	}
+
+	if (bNextSessionJoining || bNextSessionReady)
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("PreJoinNextSession: a next session is already lined up, leave it first"));
+		return;
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("Pre-joining next session as %s"), *GetNextSessionName().ToString());
+	bNextSessionJoining = true;
+	JoinSessionInternal(LocalPlayer, Request, GetNextSessionName());
+}
+
+void UCommonSessionSubsystem::MatchmakingNextSession(APlayerController* JoiningPlayer, UCommonSession_HostSessionRequest* HostRequest, UCommonSession_SearchSessionRequest*& OutMatchmakingSessionRequest)
+{
+	if (SearchSettings.IsValid() || bNextSessionJoining || bNextSessionReady)
+	{
+		UE_LOG(LogCommonSession, Log, TEXT("MatchmakingNextSession: a search or next session is already in progress. Aborting this request!"));
+		return;
+	}
+
+	bMatchmakingNextSession = true;
+	MatchmakingSession(JoiningPlayer, HostRequest, OutMatchmakingSessionRequest);
+	if (!SearchSettings.IsValid())
+	{
+		bMatchmakingNextSession = false;
+	}
+}
+
+bool UCommonSessionSubsystem::SwapToNextSession()
+{
+	if (!bNextSessionReady)
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("SwapToNextSession: no next session has been joined"));
+		return false;
+	}
+
+	const FName PreviousSessionName = ActiveSessionName;
+	ActiveSessionName = GetNextSessionName();
+	bNextSessionReady = false;
+	HostSettings.Reset();
+	GetGameInstance()->GetTimerManager().ClearTimer(HostSettingsUpdateTimerHandle);
+
+	UE_LOG(LogCommonSession, Log, TEXT("Swapping from session %s to %s"), *PreviousSessionName.ToString(), *ActiveSessionName.ToString());
+
+	// Travel does not wait on the old session, it is left in the background
+	TearDownSessionAsync(PreviousSessionName, true);
+	InternalTravelToSession(ActiveSessionName);
+	return true;
+}
+
+void UCommonSessionSubsystem::LeaveNextSession()
+{
+	if (!bNextSessionJoining && !bNextSessionReady)
+	{
+		return;
+	}
+
+	bNextSessionJoining = false;
+	bNextSessionReady = false;
+	TearDownSessionAsync(GetNextSessionName(), true);
+}
+
+void UCommonSessionSubsystem::HandleNextSessionJoined(bool bWasSuccessful)
+{
+	if (!bNextSessionJoining)
+	{
+		// Left while the join was in flight
+		return;
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("Next session %s joined (bWasSuccessful: %s)"), *GetNextSessionName().ToString(), bWasSuccessful ? TEXT("true") : TEXT("false"));
+	bNextSessionJoining = false;
+	bNextSessionReady = bWasSuccessful;
+	OnNextSessionReadyDelegate.Broadcast(bWasSuccessful);
+}
+
+#if COMMONUSER_OSSV1
+void UCommonSessionSubsystem::JoinSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request, FName SessionName)
+{
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
+	check(OnlineSub);
+	IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
+	check(Sessions);
+
+	// Resolve the server address while the join is in flight, travel picks it up from the cache
+	FString ConnectString;
+	if (bPreResolveConnectStrings && ConnectCache.IsValid() && Sessions->GetResolvedConnectString(Request->Result, NAME_GamePort, ConnectString))
+	{
+		ConnectCache->Prefetch(ConnectString);
+	}
+
+	Sessions->JoinSession(*LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId(), SessionName, Request->Result);
+}
+
+void UCommonSessionSubsystem::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	// Add any splitscreen players if they exist
+	//@TODO:
+// 	if (Result == EOnJoinSessionCompleteResult::Success && LocalPlayers.Num() > 1)
+// 	{
+// 		IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+// 		if (Sessions.IsValid() && LocalPlayers[1]->GetPreferredUniqueNetId().IsValid())
+// 		{
+// 			Sessions->RegisterLocalPlayer(*LocalPlayers[1]->GetPreferredUniqueNetId(), NAME_GameSession,
+// 				FOnRegisterLocalPlayerCompleteDelegate::CreateUObject(this, &UShooterGameInstance::OnRegisterJoiningLocalPlayerComplete));
+// 		}
+// 	}
+// 	else
+ 	{
+		FinishJoinSession(SessionName, Result);
+	}
+}
+
+void UCommonSessionSubsystem::OnRegisterJoiningLocalPlayerComplete(const FUniqueNetId& PlayerId, EOnJoinSessionCompleteResult::Type Result)
+{
+	FinishJoinSession(ActiveSessionName, Result);
+}
+
+void UCommonSessionSubsystem::FinishJoinSession(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	if (SessionName != ActiveSessionName)
+	{
+		// A pre-joined next match, travel waits for SwapToNextSession
+		HandleNextSessionJoined(Result == EOnJoinSessionCompleteResult::Success);
+		return;
+	}
+
+	// Losing a session to other players is expected under contention, quick play moves on to its next candidate
+	const bool bCanTryNextCandidate = Result == EOnJoinSessionCompleteResult::SessionIsFull || Result == EOnJoinSessionCompleteResult::SessionDoesNotExist;
+	const bool bTryingNextCandidate = HandleQuickPlayJoinFinished(Result == EOnJoinSessionCompleteResult::Success, bCanTryNextCandidate);
+
+	// A fast follow is done once its join finished, whatever the result
+	const bool bAlreadyTraveled = !FastFollowSessionId.IsEmpty() && bFastFollowTraveled;
+	FastFollowSessionId.Reset();
+	bFastFollowTraveled = false;
+
+	if (Result == EOnJoinSessionCompleteResult::Success)
+	{
+		/*
+		 * when the current session is previously joining other's session. This will also
+		 * be called on the host side. This check is workaround to prevent travel for the current host.
+		 */
+		if (!IsLocalPlayerHostingSession() && !bAlreadyTraveled)
+		{
+			InternalTravelToSession(SessionName);
+		}
+	}
+	else
+	{
+		FText ReturnReason;
+		switch (Result)
+		{
+		case EOnJoinSessionCompleteResult::SessionIsFull:
+			ReturnReason = NSLOCTEXT("NetworkErrors", "SessionIsFull", "Game is full.");
+			break;
+		case EOnJoinSessionCompleteResult::SessionDoesNotExist:
+			ReturnReason = NSLOCTEXT("NetworkErrors", "SessionDoesNotExist", "Game no longer exists.");
+			break;
+		default:
+			ReturnReason = NSLOCTEXT("NetworkErrors", "JoinSessionFailed", "Join failed.");
+			break;
+		}
+
+		if (bTryingNextCandidate)
+		{
+			UE_LOG(LogCommonSession, Log, TEXT("FinishJoinSession(Failed with Result: %s), trying the next quick play candidate"), *ReturnReason.ToString());
+			return;
+		}
+
+		//@TODO: Error handling
+		UE_LOG(LogCommonSession, Error, TEXT("FinishJoinSession(Failed with Result: %s)"), *ReturnReason.ToString());
+	}
+}
+
+#else
+
+void UCommonSessionSubsystem::JoinSessionInternalOSSv2(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request, FName SessionName)
+{
+	IOnlineServicesPtr OnlineServices = GetServices(GetWorld());
+	check(OnlineServices);
+	ILobbiesPtr Lobbies = OnlineServices->GetLobbiesInterface();
+	check(Lobbies);
+
+	FJoinLobby::Params JoinParams;
+	JoinParams.LocalUserId = LocalPlayer->GetPreferredUniqueNetId().GetV2();
+	JoinParams.LocalName = SessionName;
+	JoinParams.LobbyId = Request->Lobby->LobbyId;
+	FJoinLobbyLocalUserData& LocalUserData = JoinParams.LocalUsers.Emplace_GetRef();
+	LocalUserData.LocalUserId = LocalPlayer->GetPreferredUniqueNetId().GetV2();
+
+	// Add any splitscreen players if they exist //@TODO: See UCommonSessionSubsystem::OnJoinSessionComplete
+
+	Lobbies->JoinLobby(MoveTemp(JoinParams)).OnComplete(this, [this, SessionName](const TOnlineResult<FJoinLobby>& JoinResult)
+	{
+		if (SessionName != ActiveSessionName)
+		{
+			// A pre-joined next match, travel waits for SwapToNextSession
+			if (JoinResult.IsOk())
+			{
+				JoinedLobbies.Add(SessionName, JoinResult.GetOkValue().Lobby);
+			}
+			HandleNextSessionJoined(JoinResult.IsOk());
+			return;
+		}
+
+		if (JoinResult.IsOk())
+		{
+			HandleQuickPlayJoinFinished(true, false);
+			JoinedLobbies.Add(SessionName, JoinResult.GetOkValue().Lobby);
+			InternalTravelToSession(SessionName);
+		}
+		else
+		{
+			//@TODO: Error handling
+			UE_LOG(LogCommonSession, Error, TEXT("JoinLobby Failed with Result: %s"), *ToLogString(JoinResult.GetErrorValue()));
+			HandleQuickPlayJoinFinished(false, true);
+		}
+	});
+}
+
+UE::Online::FOnlineAccountIdHandle UCommonSessionSubsystem::GetAccountId(APlayerController* PlayerController) const
+{
+	if (const ULocalPlayer* const LocalPlayer = PlayerController->GetLocalPlayer())
+	{
+		FUniqueNetIdRepl LocalPlayerIdRepl = LocalPlayer->GetPreferredUniqueNetId();
+		if (LocalPlayerIdRepl.IsValid())
+		{
+			return LocalPlayerIdRepl.GetV2();
+		}
+	}
+	return FOnlineAccountIdHandle();
+}
+
+UE::Online::FOnlineLobbyIdHandle UCommonSessionSubsystem::GetLobbyId(const FName SessionName) const
+{
+	if (const TSharedRef<const FLobby>* Lobby = JoinedLobbies.Find(SessionName))
+	{
+		return (*Lobby)->LobbyId;
+	}
+	return FOnlineLobbyIdHandle();
+}
+
+#endif // COMMONUSER_OSSV1
+
+void UCommonSessionSubsystem::InternalTravelToSession(const FName SessionName)
+{
+	//@TODO: Ideally we'd use triggering player instead of first (they're all gonna go at once so it probably doesn't matter)
+	APlayerController* const PlayerController = GetGameInstance()->GetFirstLocalPlayerController();
+	if (PlayerController == nullptr)
+	{
+		FText ReturnReason = NSLOCTEXT("NetworkErrors", "InvalidPlayerController", "Invalid Player Controller");
+		UE_LOG(LogCommonSession, Error, TEXT("InternalTravelToSession(Failed due to %s)"), *ReturnReason.ToString());
+		return;
+	}
+
+	FString URL;
+#if COMMONUSER_OSSV1
+	// travel to session
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
+	check(OnlineSub);
+
+	IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
+	check(Sessions.IsValid());
+
+	if (!Sessions->GetResolvedConnectString(SessionName, URL))
+	{
+		FText FailReason = NSLOCTEXT("NetworkErrors", "TravelSessionFailed", "Travel to Session failed.");
+		UE_LOG(LogCommonSession, Error, TEXT("InternalTravelToSession(%s)"), *FailReason.ToString());
+		return;
+	}
+#else
+	TSharedPtr<IOnlineServices> OnlineServices = GetServices(GetWorld(), EOnlineServices::Default);
+	check(OnlineServices);
+
+	FOnlineAccountIdHandle LocalUserId = GetAccountId(PlayerController);
+	if (LocalUserId.IsValid())
+	{
+		TOnlineResult<FGetResolvedConnectString> Result = OnlineServices->GetResolvedConnectString({LocalUserId, GetLobbyId(SessionName)});
+		if (ensure(Result.IsOk()))
+		{
+			URL = Result.GetOkValue().ResolvedConnectString;
+		}
+	}
+#endif // COMMONUSER_OSSV1
+
+	if (bPreResolveConnectStrings && ConnectCache.IsValid())
+	{
+		URL = ConnectCache->Apply(URL);
+	}
+
+	TravelToConnectString(PlayerController, URL);
+}
+
+FString UCommonSessionSubsystem::GetClientTravelOption(const FString& Options, const FString& Key)
+{
+	return FCommonSessionTravelOptions::GetGameModeOption(Options, Key);
+}
+
+void UCommonSessionSubsystem::TravelToConnectString(APlayerController* PlayerController, FString URL)
+{
+	// #START @AccelByte Implementation : Add options for the prefered map, it will load the map on the server after first player join.
+	//URL.Append(TEXT("?preferedMap=%s"), *SearchSettings->);
+	// #END
+
+	// #START @AccelByte Implementation : Add options for the assigned team for this player
+	FCommonSessionTravelOptions TravelOptions;
+	for (const TPair<FString, FString>& ClientExtraArg : ClientExtraArgs)
+	{
+		if (!ClientExtraArg.Key.IsEmpty())
+		{
+			TravelOptions.SetString(FName(*ClientExtraArg.Key), ClientExtraArg.Value);
+		}
+	}
+	TravelOptions.Merge(ClientTravelOptions);
+	TravelOptions.AppendTo(URL);
+
+	// reset ClientExtraArgs
+	ClientExtraArgs.Empty();
+	ClientTravelOptions.Reset();
+	// #END
+
+	PlayerController->ClientTravel(URL, TRAVEL_Absolute);
+}
+
+#if COMMONUSER_OSSV1
+void UCommonSessionSubsystem::HandleSessionFailure(const FUniqueNetId& NetId, ESessionFailure::Type FailureType)
+{
+	UE_LOG(LogCommonSession, Warning, TEXT("UCommonSessionSubsystem::HandleSessionFailure(NetId: %s, FailureType: %s)"), *NetId.ToDebugString(), LexToString(FailureType));
+	
+	//@TODO: Probably need to do a bit more...
+}
+#endif // COMMONUSER_OSSV1
+
+void UCommonSessionSubsystem::TravelLocalSessionFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ReasonString)
+{
+	// The delegate for this is global, but PIE can have more than one game instance, so make
+	// sure it's being raised for the same world this game instance subsystem is associated with
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	UE_LOG(LogCommonSession, Warning, TEXT("TravelLocalSessionFailure(World: %s, FailureType: %s, ReasonString: %s)"),
+		*GetPathNameSafe(World),
+		ETravelFailure::ToString(FailureType),
+		*ReasonString);
+}
+
+void UCommonSessionSubsystem::HandlePostLoadMap(UWorld* World)
+{
+	// Ignore null worlds.
+	if (!World)
+	{
+		return;
+	}
+
+	// Ignore any world that isn't part of this game instance, which can be the case in the editor.
+	if (World->GetGameInstance() != GetGameInstance())
+	{
+		return;
+	}
+
+	// We don't care about updating the session unless the world type is game/pie.
+	if (!(World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE))
+	{
+		return;
+	}
+
+	ApplyActiveSessionName(World);
+
+#if COMMONUSER_OSSV1
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
+	check(OnlineSub);
+
+	const IOnlineSessionPtr SessionInterface = OnlineSub->GetSessionInterface();
+	check(SessionInterface.IsValid());
+
+	// If we're hosting a session, update the advertised map name.
+	if (HostSettings.IsValid())
+	{
+		// This needs to be the full package path to match the host GetMapName function, World->GetMapName is currently the short name
+		if (HostSettings->SetTracked(SETTING_MAPNAME, UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()), EOnlineDataAdvertisementType::ViaOnlineService))
+		{
+			QueueHostSettingsUpdate();
+		}
+	}
+#endif // COMMONUSER_OSSV1
+}
+
+void UCommonSessionSubsystem::ApplyActiveSessionName(UWorld* World)
+{
+	if (SessionNameWorld.IsValid())
+	{
+		SessionNameWorld->RemoveOnActorSpawnedHandler(SessionNameActorSpawnedHandle);
+	}
+	SessionNameWorld.Reset();
+	SessionNameActorSpawnedHandle.Reset();
+
+	// The engine defaults already match until a next session was swapped in
+	if (ActiveSessionName == NAME_GameSession)
+	{
+		return;
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("Pointing the game session and player states at session %s"), *ActiveSessionName.ToString());
+
+	AGameModeBase* GameMode = World->GetAuthGameMode();
+	if (GameMode && GameMode->GameSession)
+	{
+		GameMode->GameSession->SessionName = ActiveSessionName;
+	}
+
+	if (AGameStateBase* GameState = World->GetGameState())
+	{
+		for (APlayerState* PlayerState : GameState->PlayerArray)
+		{
+			if (PlayerState)
+			{
+				PlayerState->SessionName = ActiveSessionName;
+			}
+		}
+	}
+
+	// Player states of clients replicate in after the map loaded
+	SessionNameWorld = World;
+	SessionNameActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UCommonSessionSubsystem::HandleActorSpawnedWithSessionName));
+}
+
+void UCommonSessionSubsystem::HandleActorSpawnedWithSessionName(AActor* Actor)
+{
+	if (APlayerState* PlayerState = Cast<APlayerState>(Actor))
+	{
+		PlayerState->SessionName = ActiveSessionName;
+	}
+	else if (AGameSession* GameSession = Cast<AGameSession>(Actor))
+	{
+		GameSession->SessionName = ActiveSessionName;
+	}
+}
+
+void UCommonSessionSubsystem::SetHostSessionStringSetting(FName Key, const FString& Value)
+{
+#if COMMONUSER_OSSV1
+	if (HostSettings.IsValid() && HostSettings->SetTracked(Key, Value, EOnlineDataAdvertisementType::ViaOnlineService))
+	{
+		QueueHostSettingsUpdate();
+	}
+#endif // COMMONUSER_OSSV1
+}
+
+void UCommonSessionSubsystem::SetHostSessionIntSetting(FName Key, int32 Value)
+{
+#if COMMONUSER_OSSV1
+	if (HostSettings.IsValid() && HostSettings->SetTracked(Key, Value, EOnlineDataAdvertisementType::ViaOnlineService))
+	{
+		QueueHostSettingsUpdate();
+	}
+#endif // COMMONUSER_OSSV1
+}
+
+void UCommonSessionSubsystem::SetHostSessionMaxPlayers(int32 MaxPlayers)
+{
+#if COMMONUSER_OSSV1
+	if (HostSettings.IsValid() && HostSettings->SetNumPublicConnectionsTracked(MaxPlayers))
+	{
+		QueueHostSettingsUpdate();
+	}
+#endif // COMMONUSER_OSSV1
+}
+
+void UCommonSessionSubsystem::QueueHostSettingsUpdate()
+{
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	if (HostSettingsUpdateDelay <= 0.0f)
+	{
+		FlushHostSessionSettings();
+	}
+	else if (!TimerManager.IsTimerActive(HostSettingsUpdateTimerHandle))
+	{
+		// The window starts at the first change, anything changed before it expires rides along
+		TimerManager.SetTimer(HostSettingsUpdateTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::FlushHostSessionSettings), HostSettingsUpdateDelay, false);
+	}
+}
+
+void UCommonSessionSubsystem::FlushHostSessionSettings()
+{
+	GetGameInstance()->GetTimerManager().ClearTimer(HostSettingsUpdateTimerHandle);
+
+#if COMMONUSER_OSSV1
+	if (!HostSettings.IsValid() || !HostSettings->IsDirty())
+	{
+		return;
+	}
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	check(Sessions.IsValid());
+
+	const FName SessionName(ActiveSessionName);
+	const FOnlineSessionSettings* CurrentSettings = Sessions->GetSessionSettings(SessionName);
+	if (CurrentSettings == nullptr)
+	{
+		// Nothing to update yet, the pending values go out with the session creation
+		return;
+	}
+
+	// Start from what the session already advertises so values owned by other systems are not clobbered
+	FOnlineSessionSettings UpdatedSettings = *CurrentSettings;
+	HostSettings->ApplyDirtyTo(UpdatedSettings);
+	HostSettings->ClearDirty();
+
+	UE_LOG(LogCommonSession, Verbose, TEXT("Flushing batched host session settings for %s"), *SessionName.ToString());
+	Sessions->UpdateSession(SessionName, UpdatedSettings, true);
+#endif // COMMONUSER_OSSV1
+}
+
+int32 UCommonSessionSubsystem::GetServerPlayerCount() const
+{
+	return ServerRoster.Num();
+}
+
+bool UCommonSessionSubsystem::IsServerPlayerRegistered(const FString& AccelByteId) const
+{
+	return ServerRoster.Contains(AccelByteId);
+}
+
+void UCommonSessionSubsystem::HandleServerPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	const FUniqueNetIdPtr UserId = (NewPlayer && NewPlayer->PlayerState) ? NewPlayer->PlayerState->GetUniqueId().GetUniqueNetId() : nullptr;
+	if (!UserId.IsValid() || UserId->GetType() != ACCELBYTE_SUBSYSTEM)
+	{
+		return;
+	}
+
+	const FString AccelByteId = FUniqueNetIdAccelByteUser::Cast(*UserId)->GetAccelByteId();
+	if (ServerRoster.Contains(AccelByteId))
+	{
+		return;
+	}
+
+	ServerRoster.Add(AccelByteId, UserId.ToSharedRef());
+	if (bServerWarmSessionReady)
+	{
+		ClaimServerWarmSession();
+	}
+	if (bServerPlayerRoster)
+	{
+		if (PendingServerUnregistrations.Remove(AccelByteId) == 0)
+		{
+			// A player that left and came back within one batch is still registered, nothing to send
+			PendingServerRegistrations.Add(AccelByteId);
+		}
+		QueueServerRosterFlush();
+	}
+	UpdateServerSessionAutopilot();
+}
+
+void UCommonSessionSubsystem::HandleServerLogout(AGameModeBase* GameMode, AController* Exiting)
+{
+	const FUniqueNetIdPtr UserId = (Exiting && Exiting->PlayerState) ? Exiting->PlayerState->GetUniqueId().GetUniqueNetId() : nullptr;
+	if (!UserId.IsValid() || UserId->GetType() != ACCELBYTE_SUBSYSTEM)
+	{
+		return;
+	}
+
+	const FString AccelByteId = FUniqueNetIdAccelByteUser::Cast(*UserId)->GetAccelByteId();
+	FUniqueNetIdRef RosterId = UserId.ToSharedRef();
+	if (!ServerRoster.RemoveAndCopyValue(AccelByteId, RosterId))
+	{
+		return;
+	}
+
+	if (bServerPlayerRoster)
+	{
+		if (PendingServerRegistrations.Remove(AccelByteId) == 0)
+		{
+			PendingServerUnregistrations.Add(AccelByteId, RosterId);
 		}
+		QueueServerRosterFlush();
 	}
-	
-	SearchSettingsV1.SearchRequest->NotifySearchFinished(bWasSuccessful, bWasSuccessful ? FText() : LOCTEXT("Error_FindSessionV1Failed", "Find session failed"));
-	SearchSettings.Reset();
+	UpdateServerSessionAutopilot();
 }
-#endif // COMMONUSER_OSSV1
-
 
-void UCommonSessionSubsystem::JoinSession(APlayerController* JoiningPlayer, UCommonSession_SearchResult* Request)
+void UCommonSessionSubsystem::QueueServerRosterFlush()
 {
-	if (Request == nullptr)
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	if (TimerManager.TimerExists(ServerRosterFlushTimerHandle))
 	{
-		UE_LOG(LogCommonSession, Error, TEXT("JoinSession passed a null request"));
 		return;
 	}
 
-	ULocalPlayer* LocalPlayer = (JoiningPlayer != nullptr) ? JoiningPlayer->GetLocalPlayer() : nullptr;
-	if (LocalPlayer == nullptr)
+	// Everything that logs in or out before the timer fires goes out with the same batch
+	if (ServerRosterFlushDelay <= 0.0f)
 	{
-		UE_LOG(LogCommonSession, Error, TEXT("JoiningPlayer is invalid"));
-		return;
+		ServerRosterFlushTimerHandle = TimerManager.SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::FlushServerRoster));
+	}
+	else
+	{
+		TimerManager.SetTimer(ServerRosterFlushTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::FlushServerRoster), ServerRosterFlushDelay, false);
 	}
-
-	JoinSessionInternal(LocalPlayer, Request);
 }
 
-void UCommonSessionSubsystem::JoinSessionInternal(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request)
+void UCommonSessionSubsystem::FlushServerRoster()
 {
+	GetGameInstance()->GetTimerManager().ClearTimer(ServerRosterFlushTimerHandle);
+
 #if COMMONUSER_OSSV1
-	JoinSessionInternalOSSv1(LocalPlayer, Request);
-#else
-	JoinSessionInternalOSSv2(LocalPlayer, Request);
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	check(Sessions.IsValid());
+
+	FNamedOnlineSession* Session = Sessions->GetNamedSession(ActiveSessionName);
+	if (Session == nullptr)
+	{
+		// Kept pending, OnCreateSessionComplete flushes them once the session exists
+		UE_LOG(LogCommonSession, Verbose, TEXT("Deferring server roster flush, no %s session yet"), *ActiveSessionName.ToString());
+		return;
+	}
+
+	TArray<FUniqueNetIdRef> Unregistrations;
+	PendingServerUnregistrations.GenerateValueArray(Unregistrations);
+	PendingServerUnregistrations.Reset();
+
+	TArray<FUniqueNetIdRef> Registrations;
+	Registrations.Reserve(PendingServerRegistrations.Num());
+	for (const FString& AccelByteId : PendingServerRegistrations)
+	{
+		Registrations.Add(ServerRoster.FindChecked(AccelByteId));
+	}
+	PendingServerRegistrations.Reset();
+
+	if (Unregistrations.Num() > 0)
+	{
+		Sessions->UnregisterPlayers(ActiveSessionName, Unregistrations);
+	}
+	if (Registrations.Num() > 0)
+	{
+		Sessions->RegisterPlayers(ActiveSessionName, Registrations, false);
+	}
+
+	// One session update for the whole batch instead of one per player
+	const int32 OpenConnections = FMath::Max(Session->SessionSettings.NumPublicConnections - ServerRoster.Num(), 0);
+	if (Session->NumOpenPublicConnections != OpenConnections)
+	{
+		Session->NumOpenPublicConnections = OpenConnections;
+		Sessions->UpdateSession(ActiveSessionName, Session->SessionSettings, true);
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("Flushed server roster (Registered: %d, Unregistered: %d, Players: %d, Open: %d)"),
+		Registrations.Num(), Unregistrations.Num(), ServerRoster.Num(), OpenConnections);
 #endif // COMMONUSER_OSSV1
 }
 
-#if COMMONUSER_OSSV1
-void UCommonSessionSubsystem::JoinSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request)
+void UCommonSessionSubsystem::HandleServerMatchStateSet(FName MatchState)
 {
-	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
-	check(OnlineSub);
-	IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
-	check(Sessions);
+#if COMMONUSER_OSSV1
+	if (MatchState != MatchState::WaitingPostMatch)
+	{
+		return;
+	}
 
-	Sessions->JoinSession(*LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId(), NAME_GameSession, Request->Result);
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (Sessions.IsValid() && Sessions->GetSessionState(ActiveSessionName) == EOnlineSessionState::InProgress)
+	{
+		UE_LOG(LogCommonSession, Log, TEXT("Match finished, ending session %s"), *ActiveSessionName.ToString());
+		Sessions->EndSession(ActiveSessionName);
+	}
+#endif // COMMONUSER_OSSV1
 }
 
-void UCommonSessionSubsystem::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+void UCommonSessionSubsystem::UpdateServerSessionAutopilot()
 {
-	// Add any splitscreen players if they exist
-	//@TODO:
-// 	if (Result == EOnJoinSessionCompleteResult::Success && LocalPlayers.Num() > 1)
-// 	{
-// 		IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
-// 		if (Sessions.IsValid() && LocalPlayers[1]->GetPreferredUniqueNetId().IsValid())
-// 		{
-// 			Sessions->RegisterLocalPlayer(*LocalPlayers[1]->GetPreferredUniqueNetId(), NAME_GameSession,
-// 				FOnRegisterLocalPlayerCompleteDelegate::CreateUObject(this, &UShooterGameInstance::OnRegisterJoiningLocalPlayerComplete));
-// 		}
-// 	}
-// 	else
- 	{
-		FinishJoinSession(Result);
+#if COMMONUSER_OSSV1
+	if (!bServerSessionAutopilot || !IsRunningDedicatedServer() || bRecyclingServerSession)
+	{
+		return;
 	}
-}
 
-void UCommonSessionSubsystem::OnRegisterJoiningLocalPlayerComplete(const FUniqueNetId& PlayerId, EOnJoinSessionCompleteResult::Type Result)
-{
-	FinishJoinSession(Result);
-}
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (!Sessions.IsValid())
+	{
+		return;
+	}
 
-void UCommonSessionSubsystem::FinishJoinSession(EOnJoinSessionCompleteResult::Type Result)
-{
-	if (Result == EOnJoinSessionCompleteResult::Success)
+	const EOnlineSessionState::Type SessionState = Sessions->GetSessionState(ActiveSessionName);
+	if (SessionState == EOnlineSessionState::Pending && ServerRoster.Num() >= FMath::Max(ServerAutoStartPlayerCount, 1))
 	{
-		/*
-		 * when the current session is previously joining other's session. This will also
-		 * be called on the host side. This check is workaround to prevent travel for the current host.
-		 */
-		if (!IsLocalPlayerHostingSession())
+		StartSession();
+	}
+
+	// Only a session that was played is recycled, an empty pending session is still good for the next players
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	const bool bPlayed = SessionState == EOnlineSessionState::InProgress || SessionState == EOnlineSessionState::Ended;
+	if (ServerRoster.Num() == 0 && bPlayed && ServerIdleRecycleDelay > 0.0f)
+	{
+		if (!TimerManager.IsTimerActive(ServerIdleTimerHandle))
 		{
-			InternalTravelToSession(NAME_GameSession);
+			TimerManager.SetTimer(ServerIdleTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::HandleServerSessionIdle), ServerIdleRecycleDelay, false);
 		}
 	}
 	else
 	{
-		FText ReturnReason;
-		switch (Result)
-		{
-		case EOnJoinSessionCompleteResult::SessionIsFull:
-			ReturnReason = NSLOCTEXT("NetworkErrors", "SessionIsFull", "Game is full.");
-			break;
-		case EOnJoinSessionCompleteResult::SessionDoesNotExist:
-			ReturnReason = NSLOCTEXT("NetworkErrors", "SessionDoesNotExist", "Game no longer exists.");
-			break;
-		default:
-			ReturnReason = NSLOCTEXT("NetworkErrors", "JoinSessionFailed", "Join failed.");
-			break;
-		}
-
-		//@TODO: Error handling
-		UE_LOG(LogCommonSession, Error, TEXT("FinishJoinSession(Failed with Result: %s)"), *ReturnReason.ToString());
+		TimerManager.ClearTimer(ServerIdleTimerHandle);
 	}
+#endif // COMMONUSER_OSSV1
 }
 
-#else
-
-void UCommonSessionSubsystem::JoinSessionInternalOSSv2(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request)
+void UCommonSessionSubsystem::HandleServerSessionIdle()
 {
-	const FName SessionName(NAME_GameSession);
-	IOnlineServicesPtr OnlineServices = GetServices(GetWorld());
-	check(OnlineServices);
-	ILobbiesPtr Lobbies = OnlineServices->GetLobbiesInterface();
-	check(Lobbies);
-
-	FJoinLobby::Params JoinParams;
-	JoinParams.LocalUserId = LocalPlayer->GetPreferredUniqueNetId().GetV2();
-	JoinParams.LocalName = SessionName;
-	JoinParams.LobbyId = Request->Lobby->LobbyId;
-	FJoinLobbyLocalUserData& LocalUserData = JoinParams.LocalUsers.Emplace_GetRef();
-	LocalUserData.LocalUserId = LocalPlayer->GetPreferredUniqueNetId().GetV2();
+#if COMMONUSER_OSSV1
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	const FOnlineSessionSettings* CurrentSettings = Sessions.IsValid() ? Sessions->GetSessionSettings(ActiveSessionName) : nullptr;
+	if (CurrentSettings == nullptr || ServerRoster.Num() > 0)
+	{
+		return;
+	}
 
-	// Add any splitscreen players if they exist //@TODO: See UCommonSessionSubsystem::OnJoinSessionComplete
+	UE_LOG(LogCommonSession, Log, TEXT("Session %s stayed empty for %.0fs, recycling it"), *ActiveSessionName.ToString(), ServerIdleRecycleDelay);
 
-	Lobbies->JoinLobby(MoveTemp(JoinParams)).OnComplete(this, [this, SessionName](const TOnlineResult<FJoinLobby>& JoinResult)
+	// The replacement advertises the same settings, or the warm session template if one is armed, the backend sees a fresh session for the next match
+	bRecyclingServerSession = true;
+	if (ServerWarmSessionTemplate)
 	{
-		if (JoinResult.IsOk())
+		// Later host setting batches apply on top of the template, pending ones were meant for the old session
+		GetGameInstance()->GetTimerManager().ClearTimer(HostSettingsUpdateTimerHandle);
+		HostSettings = BuildHostSettingsOSSv1(ServerWarmSessionTemplate);
+	}
+	const FOnlineSessionSettings Settings = ServerWarmSessionTemplate ? static_cast<const FOnlineSessionSettings&>(*HostSettings) : *CurrentSettings;
+	TearDownSessionAsync(ActiveSessionName, false).Next([WeakThis = TWeakObjectPtr<UCommonSessionSubsystem>(this), Settings](bool bWasSuccessful)
+	{
+		UCommonSessionSubsystem* This = WeakThis.Get();
+		if (This == nullptr)
 		{
-			InternalTravelToSession(SessionName);
+			return;
 		}
-		else
+
+		IOnlineSessionPtr Sessions = Online::GetSessionInterface(This->GetWorld());
+		if (!bWasSuccessful || !Sessions.IsValid() || !Sessions->CreateSession(0, This->ActiveSessionName, Settings))
 		{
-			//@TODO: Error handling
-			UE_LOG(LogCommonSession, Error, TEXT("JoinLobby Failed with Result: %s"), *ToLogString(JoinResult.GetErrorValue()));
+			This->HandleServerSessionRecreated(false);
 		}
 	});
+#endif // COMMONUSER_OSSV1
 }
 
-UE::Online::FOnlineAccountIdHandle UCommonSessionSubsystem::GetAccountId(APlayerController* PlayerController) const
+void UCommonSessionSubsystem::HandleServerSessionRecreated(bool bWasSuccessful)
 {
-	if (const ULocalPlayer* const LocalPlayer = PlayerController->GetLocalPlayer())
+	bRecyclingServerSession = false;
+
+	if (bWasSuccessful)
 	{
-		FUniqueNetIdRepl LocalPlayerIdRepl = LocalPlayer->GetPreferredUniqueNetId();
-		if (LocalPlayerIdRepl.IsValid())
-		{
-			return LocalPlayerIdRepl.GetV2();
-		}
+		UE_LOG(LogCommonSession, Log, TEXT("Recycled session %s"), *ActiveSessionName.ToString());
 	}
-	return FOnlineAccountIdHandle();
-}
-
-UE::Online::FOnlineLobbyIdHandle UCommonSessionSubsystem::GetLobbyId(const FName SessionName) const
-{
-	FOnlineAccountIdHandle LocalUserId = GetAccountId(GetGameInstance()->GetFirstLocalPlayerController());
-	if (LocalUserId.IsValid())
+	else
 	{
-		IOnlineServicesPtr OnlineServices = GetServices(GetWorld());
-		check(OnlineServices);
-		ILobbiesPtr Lobbies = OnlineServices->GetLobbiesInterface();
-		check(Lobbies);
-		TOnlineResult<FGetJoinedLobbies> JoinedLobbies = Lobbies->GetJoinedLobbies({ LocalUserId });
-		if (JoinedLobbies.IsOk())
-		{
-			for (const TSharedRef<const FLobby>& Lobby : JoinedLobbies.GetOkValue().Lobbies)
-			{
-				if (Lobby->LocalName == SessionName)
-				{
-					return Lobby->LobbyId;
-				}
-			}
-		}
+		UE_LOG(LogCommonSession, Error, TEXT("Failed to recycle session %s"), *ActiveSessionName.ToString());
 	}
-	return FOnlineLobbyIdHandle();
-}
 
-#endif // COMMONUSER_OSSV1
-
-void UCommonSessionSubsystem::InternalTravelToSession(const FName SessionName)
-{
-	//@TODO: Ideally we'd use triggering player instead of first (they're all gonna go at once so it probably doesn't matter)
-	APlayerController* const PlayerController = GetGameInstance()->GetFirstLocalPlayerController();
-	if (PlayerController == nullptr)
+	// A session recycled from the template is a freshly armed warm session and only reports as one
+	if (bWasSuccessful && ServerWarmSessionTemplate)
 	{
-		FText ReturnReason = NSLOCTEXT("NetworkErrors", "InvalidPlayerController", "Invalid Player Controller");
-		UE_LOG(LogCommonSession, Error, TEXT("InternalTravelToSession(Failed due to %s)"), *ReturnReason.ToString());
+		HandleServerWarmSessionCreated(true);
 		return;
 	}
 
-	FString URL;
-#if COMMONUSER_OSSV1
-	// travel to session
-	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
-	check(OnlineSub);
-
-	IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
-	check(Sessions.IsValid());
+	OnServerSessionRecycledDelegate.Broadcast(bWasSuccessful);
 
-	if (!Sessions->GetResolvedConnectString(SessionName, URL))
+	// Players may have connected while the session was being recreated
+	if (bWasSuccessful && ServerRoster.Num() > 0)
 	{
-		FText FailReason = NSLOCTEXT("NetworkErrors", "TravelSessionFailed", "Travel to Session failed.");
-		UE_LOG(LogCommonSession, Error, TEXT("InternalTravelToSession(%s)"), *FailReason.ToString());
-		return;
+		if (bServerPlayerRoster)
+		{
+			QueueServerRosterFlush();
+		}
+		UpdateServerSessionAutopilot();
 	}
-#else
-	TSharedPtr<IOnlineServices> OnlineServices = GetServices(GetWorld(), EOnlineServices::Default);
-	check(OnlineServices);
+}
 
-	FOnlineAccountIdHandle LocalUserId = GetAccountId(PlayerController);
-	if (LocalUserId.IsValid())
+bool UCommonSessionSubsystem::ArmServerWarmSession(UCommonSession_HostSessionRequest* Template)
+{
+#if COMMONUSER_OSSV1
+	if (Template == nullptr || !IsRunningDedicatedServer())
 	{
-		TOnlineResult<FGetResolvedConnectString> Result = OnlineServices->GetResolvedConnectString({LocalUserId, GetLobbyId(SessionName)});
-		if (ensure(Result.IsOk()))
-		{
-			URL = Result.GetOkValue().ResolvedConnectString;
-		}
+		UE_LOG(LogCommonSession, Error, TEXT("ArmServerWarmSession needs a template and a dedicated server"));
+		return false;
 	}
-#endif // COMMONUSER_OSSV1
 
-	// #START @AccelByte Implementation : Add options for the prefered map, it will load the map on the server after first player join.
-	//URL.Append(TEXT("?preferedMap=%s"), *SearchSettings->);
-	// #END
+	ServerWarmSessionTemplate = Template;
 
-	// #START @AccelByte Implementation : Add options for the assigned team for this player
-	for (TTuple<FString, FString> ClientExtraArg : ClientExtraArgs)
+	// A running session is replaced by a warm one once it is destroyed
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (Sessions.IsValid() && Sessions->GetSessionState(ActiveSessionName) == EOnlineSessionState::NoSession)
 	{
-		URL.Append(FString::Printf(TEXT("?%s=%s"), *ClientExtraArg.Key, *ClientExtraArg.Value));
+		CreateServerWarmSession();
 	}
-	// reset ClientExtraArgs
-	ClientExtraArgs.Empty();
-	// #END
-
-	PlayerController->ClientTravel(URL, TRAVEL_Absolute);
+	return true;
+#else
+	UE_LOG(LogCommonSession, Warning, TEXT("ArmServerWarmSession is only supported with OSSv1"));
+	return false;
+#endif // COMMONUSER_OSSV1
 }
 
-#if COMMONUSER_OSSV1
-void UCommonSessionSubsystem::HandleSessionFailure(const FUniqueNetId& NetId, ESessionFailure::Type FailureType)
+void UCommonSessionSubsystem::DisarmServerWarmSession()
 {
-	UE_LOG(LogCommonSession, Warning, TEXT("UCommonSessionSubsystem::HandleSessionFailure(NetId: %s, FailureType: %s)"), *NetId.ToDebugString(), LexToString(FailureType));
-	
-	//@TODO: Probably need to do a bit more...
+	ServerWarmSessionTemplate = nullptr;
+	bServerWarmSessionReady = false;
+	GetGameInstance()->GetTimerManager().ClearTimer(ServerWarmSessionTimerHandle);
 }
-#endif // COMMONUSER_OSSV1
 
-void UCommonSessionSubsystem::TravelLocalSessionFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ReasonString)
+bool UCommonSessionSubsystem::ClaimServerWarmSession()
 {
-	// The delegate for this is global, but PIE can have more than one game instance, so make
-	// sure it's being raised for the same world this game instance subsystem is associated with
-	if (World != GetWorld())
+	if (!bServerWarmSessionReady)
 	{
-		return;
+		return false;
 	}
 
-	UE_LOG(LogCommonSession, Warning, TEXT("TravelLocalSessionFailure(World: %s, FailureType: %s, ReasonString: %s)"),
-		*GetPathNameSafe(World),
-		ETravelFailure::ToString(FailureType),
-		*ReasonString);
+	bServerWarmSessionReady = false;
+	UE_LOG(LogCommonSession, Log, TEXT("Claimed warm session %s after %.1fs ready"), *ActiveSessionName.ToString(), FPlatformTime::Seconds() - ServerWarmSessionReadyTime);
+
+	// Hand the session to the match, values it set on top of the template go out before the session starts
+	FlushHostSessionSettings();
+	if (bServerSessionAutopilot)
+	{
+		// The autopilot starts it once ServerAutoStartPlayerCount players are in
+		UpdateServerSessionAutopilot();
+	}
+	else
+	{
+		StartSession();
+	}
+	return true;
 }
 
-void UCommonSessionSubsystem::HandlePostLoadMap(UWorld* World)
+void UCommonSessionSubsystem::CreateServerWarmSession()
 {
-	// Ignore null worlds.
-	if (!World)
+	GetGameInstance()->GetTimerManager().ClearTimer(ServerWarmSessionTimerHandle);
+
+#if COMMONUSER_OSSV1
+	if (!ServerWarmSessionTemplate || bArmingServerWarmSession || bRecyclingServerSession)
 	{
 		return;
 	}
 
-	// Ignore any world that isn't part of this game instance, which can be the case in the editor.
-	if (World->GetGameInstance() != GetGameInstance())
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (!Sessions.IsValid() || Sessions->GetSessionState(ActiveSessionName) != EOnlineSessionState::NoSession)
 	{
 		return;
 	}
 
-	// We don't care about updating the session unless the world type is game/pie.
-	if (!(World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE))
+	// Kept as the host settings so a claiming match can change them through the batched host setting updates
+	HostSettings = BuildHostSettingsOSSv1(ServerWarmSessionTemplate);
+	bArmingServerWarmSession = true;
+
+	UE_LOG(LogCommonSession, Log, TEXT("Arming warm session %s"), *ActiveSessionName.ToString());
+	if (!Sessions->CreateSession(0, ActiveSessionName, *HostSettings))
 	{
-		return;
+		HandleServerWarmSessionCreated(false);
 	}
+#endif // COMMONUSER_OSSV1
+}
 
-#if COMMONUSER_OSSV1
-	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
-	check(OnlineSub);
-
-	const IOnlineSessionPtr SessionInterface = OnlineSub->GetSessionInterface();
-	check(SessionInterface.IsValid());
+void UCommonSessionSubsystem::HandleServerWarmSessionCreated(bool bWasSuccessful)
+{
+	bArmingServerWarmSession = false;
+	bServerWarmSessionReady = bWasSuccessful && ServerWarmSessionTemplate;
 
-	// If we're hosting a session, update the advertised map name.
-	if (HostSettings.IsValid())
+	if (bServerWarmSessionReady)
 	{
-		// This needs to be the full package path to match the host GetMapName function, World->GetMapName is currently the short name
-		HostSettings->Set(SETTING_MAPNAME, UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()), EOnlineDataAdvertisementType::ViaOnlineService);
+		ServerWarmSessionReadyTime = FPlatformTime::Seconds();
+		UE_LOG(LogCommonSession, Log, TEXT("Warm session %s is ready"), *ActiveSessionName.ToString());
 
-		const FName SessionName(NAME_GameSession);
-		SessionInterface->UpdateSession(SessionName, *HostSettings, true);
+		// Players that connected while the session was armed claim it right away, their registrations were deferred until now
+		if (ServerRoster.Num() > 0)
+		{
+			if (bServerPlayerRoster)
+			{
+				QueueServerRosterFlush();
+			}
+			ClaimServerWarmSession();
+		}
 	}
-#endif // COMMONUSER_OSSV1
+	else if (ServerWarmSessionTemplate)
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("Failed to arm warm session %s, retrying in %.1fs"), *ActiveSessionName.ToString(), ServerWarmSessionRetryDelay);
+		GetGameInstance()->GetTimerManager().SetTimer(ServerWarmSessionTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::CreateServerWarmSession), FMath::Max(ServerWarmSessionRetryDelay, 0.1f), false);
+	}
+
+	OnServerWarmSessionReadyDelegate.Broadcast(bWasSuccessful);
 }
 
 #undef LOCTEXT_NAMESPACE
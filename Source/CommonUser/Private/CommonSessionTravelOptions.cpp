@@ -0,0 +1,327 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#include "CommonSessionTravelOptions.h"
+
+#include "CommonSessionLog.h"
+
+namespace CommonSessionTravelOption
+{
+	const FName Listen(TEXT("listen"));
+	const FName LanMatch(TEXT("bIsLanMatch"));
+	const FName NumBots(TEXT("NumBots"));
+}
+
+namespace
+{
+	/** Characters that would break the ?Key=Value structure of a travel URL */
+	bool NeedsEscape(TCHAR Char)
+	{
+		return Char == TCHAR('?') || Char == TCHAR('=') || Char == TCHAR('#') || Char == TCHAR('%') || Char <= TCHAR(' ');
+	}
+
+	int32 HexDigitValue(TCHAR Char)
+	{
+		if (Char >= TCHAR('0') && Char <= TCHAR('9'))
+		{
+			return Char - TCHAR('0');
+		}
+		if (Char >= TCHAR('A') && Char <= TCHAR('F'))
+		{
+			return Char - TCHAR('A') + 10;
+		}
+		if (Char >= TCHAR('a') && Char <= TCHAR('f'))
+		{
+			return Char - TCHAR('a') + 10;
+		}
+		return INDEX_NONE;
+	}
+}
+
+void FCommonSessionTravelOptions::SetFlag(FName Key)
+{
+	if (IsValidKey(Key))
+	{
+		FOption& Option = FindOrAddOption(Key);
+		Option.Type = EValueType::Flag;
+		Option.StringValue.Reset();
+	}
+}
+
+void FCommonSessionTravelOptions::SetInt(FName Key, int32 Value)
+{
+	if (IsValidKey(Key))
+	{
+		FOption& Option = FindOrAddOption(Key);
+		Option.Type = EValueType::Int;
+		Option.IntValue = Value;
+		Option.StringValue.Reset();
+	}
+}
+
+void FCommonSessionTravelOptions::SetBool(FName Key, bool Value)
+{
+	if (IsValidKey(Key))
+	{
+		FOption& Option = FindOrAddOption(Key);
+		Option.Type = EValueType::Bool;
+		Option.IntValue = Value ? 1 : 0;
+		Option.StringValue.Reset();
+	}
+}
+
+void FCommonSessionTravelOptions::SetString(FName Key, const FString& Value)
+{
+	if (IsValidKey(Key))
+	{
+		FOption& Option = FindOrAddOption(Key);
+		Option.Type = EValueType::String;
+		Option.StringValue = Value;
+	}
+}
+
+void FCommonSessionTravelOptions::Merge(const FCommonSessionTravelOptions& Other)
+{
+	for (const FOption& OtherOption : Other.Options)
+	{
+		FindOrAddOption(OtherOption.Key) = OtherOption;
+	}
+}
+
+void FCommonSessionTravelOptions::Remove(FName Key)
+{
+	Options.RemoveAll([Key](const FOption& Option) { return Option.Key == Key; });
+}
+
+void FCommonSessionTravelOptions::Reset()
+{
+	Options.Reset();
+}
+
+bool FCommonSessionTravelOptions::Contains(FName Key) const
+{
+	return FindOption(Key) != nullptr;
+}
+
+TOptional<int32> FCommonSessionTravelOptions::GetInt(FName Key) const
+{
+	if (const FOption* Option = FindOption(Key))
+	{
+		switch (Option->Type)
+		{
+		case EValueType::Int:
+		case EValueType::Bool:
+			return Option->IntValue;
+		case EValueType::String:
+			if (Option->StringValue.IsNumeric())
+			{
+				return FCString::Atoi(*Option->StringValue);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	return TOptional<int32>();
+}
+
+TOptional<bool> FCommonSessionTravelOptions::GetBool(FName Key) const
+{
+	if (const FOption* Option = FindOption(Key))
+	{
+		switch (Option->Type)
+		{
+		case EValueType::Flag:
+			return true;
+		case EValueType::Int:
+		case EValueType::Bool:
+			return Option->IntValue != 0;
+		case EValueType::String:
+			return Option->StringValue.ToBool();
+		}
+	}
+	return TOptional<bool>();
+}
+
+TOptional<FString> FCommonSessionTravelOptions::GetString(FName Key) const
+{
+	if (const FOption* Option = FindOption(Key))
+	{
+		switch (Option->Type)
+		{
+		case EValueType::Flag:
+			return FString();
+		case EValueType::Int:
+		case EValueType::Bool:
+			return FString::FromInt(Option->IntValue);
+		case EValueType::String:
+			return Option->StringValue;
+		}
+	}
+	return TOptional<FString>();
+}
+
+void FCommonSessionTravelOptions::AppendTo(FString& URL) const
+{
+	// Size the buffer once, string values are counted as if every character had to be escaped
+	int32 RequiredLength = URL.Len();
+	for (const FOption& Option : Options)
+	{
+		RequiredLength += 2 + Option.Key.GetStringLength();
+		RequiredLength += (Option.Type == EValueType::String) ? Option.StringValue.Len() * 3 : 11;
+	}
+	URL.Reserve(RequiredLength);
+
+	for (const FOption& Option : Options)
+	{
+		URL.AppendChar(TCHAR('?'));
+		Option.Key.AppendString(URL);
+
+		switch (Option.Type)
+		{
+		case EValueType::Flag:
+			break;
+		case EValueType::Int:
+		case EValueType::Bool:
+			URL.AppendChar(TCHAR('='));
+			URL.AppendInt(Option.IntValue);
+			break;
+		case EValueType::String:
+			if (!Option.StringValue.IsEmpty())
+			{
+				URL.AppendChar(TCHAR('='));
+				AppendEscaped(URL, Option.StringValue);
+			}
+			break;
+		}
+	}
+}
+
+FString FCommonSessionTravelOptions::ToString() const
+{
+	FString Result;
+	AppendTo(Result);
+	return Result;
+}
+
+FCommonSessionTravelOptions FCommonSessionTravelOptions::Parse(const FString& OptionsString)
+{
+	FCommonSessionTravelOptions Result;
+
+	// Anything before the first '?' is the map or address part of the URL
+	int32 OptionsStart = INDEX_NONE;
+	if (!OptionsString.FindChar(TCHAR('?'), OptionsStart))
+	{
+		return Result;
+	}
+
+	TArray<FString> Pairs;
+	OptionsString.RightChop(OptionsStart + 1).ParseIntoArray(Pairs, TEXT("?"), true);
+	for (const FString& Pair : Pairs)
+	{
+		FString Key;
+		FString Value;
+		if (!Pair.Split(TEXT("="), &Key, &Value))
+		{
+			Result.SetFlag(FName(*Pair));
+		}
+		else
+		{
+			// Kept as written, the typed getters convert on read so values like "007" are not altered
+			Result.SetString(FName(*Key), Unescape(Value));
+		}
+	}
+
+	return Result;
+}
+
+FString FCommonSessionTravelOptions::GetGameModeOption(const FString& Options, const FString& Key)
+{
+	return FromGameModeOptions(Options).GetString(FName(*Key)).Get(FString());
+}
+
+FCommonSessionTravelOptions::FOption* FCommonSessionTravelOptions::FindOption(FName Key)
+{
+	return Options.FindByPredicate([Key](const FOption& Option) { return Option.Key == Key; });
+}
+
+const FCommonSessionTravelOptions::FOption* FCommonSessionTravelOptions::FindOption(FName Key) const
+{
+	return Options.FindByPredicate([Key](const FOption& Option) { return Option.Key == Key; });
+}
+
+FCommonSessionTravelOptions::FOption& FCommonSessionTravelOptions::FindOrAddOption(FName Key)
+{
+	if (FOption* Existing = FindOption(Key))
+	{
+		return *Existing;
+	}
+
+	FOption& Option = Options.AddDefaulted_GetRef();
+	Option.Key = Key;
+	return Option;
+}
+
+bool FCommonSessionTravelOptions::IsValidKey(FName Key)
+{
+	if (Key.IsNone())
+	{
+		return false;
+	}
+
+	// Keys can come from client URLs and Blueprint extra args, bad input is dropped rather than asserted on
+	const FString KeyString = Key.ToString();
+	for (const TCHAR Char : KeyString)
+	{
+		if (NeedsEscape(Char))
+		{
+			UE_LOG(LogCommonSession, Warning, TEXT("Travel option key '%s' contains a reserved character and was ignored"), *KeyString);
+			return false;
+		}
+	}
+	return true;
+}
+
+void FCommonSessionTravelOptions::AppendEscaped(FString& Out, const FString& Value)
+{
+	static const TCHAR* HexDigits = TEXT("0123456789ABCDEF");
+
+	for (const TCHAR Char : Value)
+	{
+		if (NeedsEscape(Char))
+		{
+			Out.AppendChar(TCHAR('%'));
+			Out.AppendChar(HexDigits[(Char >> 4) & 0xF]);
+			Out.AppendChar(HexDigits[Char & 0xF]);
+		}
+		else
+		{
+			Out.AppendChar(Char);
+		}
+	}
+}
+
+FString FCommonSessionTravelOptions::Unescape(const FString& Value)
+{
+	int32 EscapeIndex = INDEX_NONE;
+	if (!Value.FindChar(TCHAR('%'), EscapeIndex))
+	{
+		return Value;
+	}
+
+	FString Result;
+	Result.Reserve(Value.Len());
+	for (int32 Index = 0; Index < Value.Len(); ++Index)
+	{
+		const TCHAR Char = Value[Index];
+		if (Char == TCHAR('%') && Index + 2 < Value.Len() && HexDigitValue(Value[Index + 1]) != INDEX_NONE && HexDigitValue(Value[Index + 2]) != INDEX_NONE)
+		{
+			Result.AppendChar((TCHAR)(HexDigitValue(Value[Index + 1]) * 16 + HexDigitValue(Value[Index + 2])));
+			Index += 2;
+		}
+		else
+		{
+			Result.AppendChar(Char);
+		}
+	}
+	return Result;
+}
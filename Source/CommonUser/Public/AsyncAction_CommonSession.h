@@ -18,22 +18,23 @@ class COMMONUSER_API UAsyncAction_CommonSessionEndSession : public UBlueprintAsy
 
 public:
 	/**
-	 * Retrieved cached friends, incoming, and outgoing friends request list. If there's no cached data, retrieve from API
+	 * Ends and destroys the current game session through the session subsystem teardown pipeline
 	 *
-	 * @param LocalPlayer Local player object
+	 * @param InCommonSession Session subsystem that owns the game session
+	 * @param bInFastLeave If true, skip ending the session when the backend allows destroying it directly
 	 */
-	UFUNCTION(BlueprintCallable, Category = "AccelByte | Common | Friends", meta = (BlueprintInternalUseOnly = "true"))
-	static UAsyncAction_CommonSessionEndSession* TryToEndSession(UCommonSessionSubsystem* InCommonSession);
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Common | Session", meta = (BlueprintInternalUseOnly = "true"))
+	static UAsyncAction_CommonSessionEndSession* TryToEndSession(UCommonSessionSubsystem* InCommonSession, bool bInFastLeave = false);
 
 	UPROPERTY(BlueprintAssignable)
 	FOnCompleteDestroySession OnComplete;
 
 protected:
-	void HandleDestroySessionComplete(FName Name, bool bWasSuccessful);
-	void HandleOnEndSessionComplete(FName GameSession, bool bWasSuccessful);
+	void HandleCleanUpSessionsComplete(bool bWasSuccessful);
 	
 	virtual void Activate() override;
 	
 	TWeakObjectPtr<UCommonSessionSubsystem> CommonSession;
+	bool bFastLeave = false;
 };
 
@@ -0,0 +1,67 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonMatchmakingQueueStats.generated.h"
+
+/**
+ * Rolling histogram of how long matchmaking took for one queue.
+ * Buckets have fixed upper bounds, older samples fade out as new ones are added.
+ */
+USTRUCT()
+struct COMMONUSER_API FCommonMatchmakingQueueHistogram
+{
+	GENERATED_BODY()
+
+	/** Queue the samples were recorded for, the AccelByte game mode */
+	UPROPERTY()
+	FString Queue;
+
+	/** Decayed sample weight per bucket, see BucketUpperBounds */
+	UPROPERTY()
+	TArray<float> BucketWeights;
+
+	/** Number of samples ever recorded */
+	UPROPERTY()
+	int32 NumSamples = 0;
+
+	UPROPERTY()
+	FDateTime LastSampleTime;
+
+	/** Adds a queue duration, scaling the existing weights by Decay first */
+	void AddSample(float Seconds, float Decay);
+
+	/** Returns the queue time below which the given fraction of recorded players got a match, unset without samples */
+	TOptional<float> GetPercentile(float Fraction) const;
+
+	/** Returns the fraction of recorded players that got a match in less than Seconds */
+	float GetFractionBelow(float Seconds) const;
+
+	/** Upper bound in seconds of every bucket, the last bucket is open ended */
+	static const TArray<float>& GetBucketUpperBounds();
+};
+
+/** Queue time histograms of every queue the local player used, persisted between runs */
+USTRUCT()
+struct COMMONUSER_API FCommonMatchmakingQueueStats
+{
+	GENERATED_BODY()
+
+	static constexpr int32 CurrentVersion = 1;
+
+	UPROPERTY()
+	int32 Version = CurrentVersion;
+
+	UPROPERTY()
+	TArray<FCommonMatchmakingQueueHistogram> Queues;
+
+	/** Replaces the stats with the saved ones, returns false and leaves them empty if there is no usable file */
+	bool Load();
+	bool Save() const;
+
+	const FCommonMatchmakingQueueHistogram* Find(const FString& Queue) const;
+	FCommonMatchmakingQueueHistogram& FindOrAdd(const FString& Queue);
+
+	static FString GetFilePath();
+};
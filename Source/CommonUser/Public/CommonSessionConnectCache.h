@@ -0,0 +1,51 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FResolveInfo;
+
+/**
+ * Resolves the host names of session connect strings ahead of travel.
+ * A lookup is started as soon as a session is known, and travel swaps the host for the resolved address,
+ * so the net driver does not block on name resolution while connecting.
+ */
+class COMMONUSER_API FCommonSessionConnectCache
+{
+public:
+	~FCommonSessionConnectCache();
+
+	/** Starts resolving the host of the connect string, does nothing if it is numeric, already resolved or pending */
+	void Prefetch(const FString& ConnectString);
+
+	/** Returns the connect string with its host replaced by the resolved address, or unchanged if it has not resolved */
+	FString Apply(const FString& ConnectString) const;
+
+	/** Forgets resolved addresses, lookups that are still running are kept */
+	void Reset();
+
+private:
+	/** Splits a connect string into host and the remainder (port and options), returns false if there is no host */
+	static bool SplitHost(const FString& ConnectString, FString& OutHost, FString& OutRemainder);
+
+	bool Tick(float DeltaTime);
+
+	struct FResolvedHost
+	{
+		FString Address;
+		double ResolveTime = 0.0;
+	};
+
+	struct FPendingHost
+	{
+		FString Host;
+		FResolveInfo* ResolveInfo = nullptr;
+	};
+
+	TMap<FString, FResolvedHost> ResolvedHosts;
+	TArray<FPendingHost> PendingHosts;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,61 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/PrimaryAssetId.h"
+
+struct FAssetData;
+
+/** Everything the session code needs to know about a hostable map, resolved once from the asset manager */
+struct COMMONUSER_API FCommonSessionMapCatalogEntry
+{
+	FPrimaryAssetId MapID;
+
+	/** Full package path used for travel and advertised as SETTING_MAPNAME */
+	FString PackageName;
+
+	/** Short asset name, suitable for display and logging */
+	FString AdvertisedName;
+
+	/** Asset registry tag values that are advertised on hosted sessions and used as matchmaking filters */
+	TMap<FName, FString> MatchmakingTags;
+};
+
+/**
+ * Index of map primary assets keyed by MapID.
+ * Built the first time it is queried and rebuilt lazily after the asset registry reports changes,
+ * so host, search and travel paths resolve a map without going through the asset manager each time.
+ */
+class COMMONUSER_API FCommonSessionMapCatalog
+{
+public:
+	FCommonSessionMapCatalog(const TArray<FPrimaryAssetType>& InAssetTypes, const TArray<FName>& InMatchmakingTagKeys);
+	~FCommonSessionMapCatalog();
+
+	/** Returns the entry for the map, or null if it is not a known primary asset */
+	const FCommonSessionMapCatalogEntry* Find(const FPrimaryAssetId& MapID);
+
+	/** Drops all entries, the catalog is rebuilt on the next lookup */
+	void Invalidate();
+
+private:
+	void Rebuild();
+	const FCommonSessionMapCatalogEntry& AddEntry(const FPrimaryAssetId& MapID, const FAssetData& AssetData);
+
+	void HandleAssetChanged(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	TArray<FPrimaryAssetType> AssetTypes;
+	TArray<FName> MatchmakingTagKeys;
+
+	TMap<FPrimaryAssetId, FCommonSessionMapCatalogEntry> Entries;
+
+	/** True when the entries need to be rebuilt before the next lookup */
+	bool bDirty = true;
+
+	FDelegateHandle FilesLoadedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+};
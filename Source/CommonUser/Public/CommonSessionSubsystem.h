@@ -7,6 +7,9 @@
 #include "Engine/GameInstance.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "UObject/StrongObjectPtr.h"
+#include "Async/Future.h"
+#include "CommonSessionTravelOptions.h"
+#include "CommonMatchmakingQueueStats.h"
 
 #if COMMONUSER_OSSV1
 #include "OnlineSubsystemTypes.h"
@@ -20,6 +23,15 @@
 
 class UWorld;
 class FCommonSession_OnlineSessionSettings;
+class FCommonSessionMapCatalog;
+class FCommonSessionConnectCache;
+struct FCommonMatchmakingRetry;
+struct FCommonMatchmakingTicket;
+struct FCommonQuickPlayJoin;
+struct FCommonQuickPlayRace;
+struct FCommonSessionMapCatalogEntry;
+struct FCommonSessionTeardown;
+enum class ECommonSessionTeardownStep : uint8;
 
 #if COMMONUSER_OSSV1
 class FCommonOnlineSearchSettingsOSSv1;
@@ -50,6 +62,18 @@ enum class ECommonSessionOnlineServerType : uint8
 	Dedicated
 };
 
+/** When the session subsystem confirms matchmaking ready consent on its own */
+UENUM(BlueprintType)
+enum class ECommonReadyConsentPolicy : uint8
+{
+	/** Left to the game, usually from UI bound to OnMatchFoundDelegate */
+	Manual,
+	/** Confirmed as soon as it is requested */
+	Always,
+	/** Confirmed as soon as it is requested while the local player is in a party with other members */
+	InParty
+};
+
 /** A request object that stores the parameters used when hosting a gameplay session */
 UCLASS(BlueprintType)
 class COMMONUSER_API UCommonSession_HostSessionRequest : public UObject
@@ -84,6 +108,10 @@ public:
 	/** #START @AccelByte Implementation : GameMode on matchmaking service */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category=Experience)
 	FString AccelByteGameMode;
+
+	/** Other matchmaking queues the player is willing to play, tried in order when the previous queue fails or times out */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category=Experience)
+	TArray<FString> AccelByteAlternateGameModes;
 	
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category=Experience)
 	ECommonSessionOnlineServerType ServerType{ECommonSessionOnlineServerType::NONE};
@@ -99,8 +127,27 @@ public:
 	/** Constructs the full URL that will be passed to ServerTravel */
 	virtual FString ConstructTravelURL() const;
 
+	/** Returns the typed URL options for this request, combining ExtraArgs with the typed options */
+	virtual FCommonSessionTravelOptions GetTravelOptions() const;
+
+	/** Sets a typed integer URL option, takes precedence over an ExtraArgs entry with the same key */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void SetIntTravelOption(FName Key, int32 Value);
+
+	/** Sets a typed bool URL option, takes precedence over an ExtraArgs entry with the same key */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void SetBoolTravelOption(FName Key, bool Value);
+
+	/** Sets a string URL option, the value is escaped when the URL is built */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void SetStringTravelOption(FName Key, const FString& Value);
+
 	/** Returns true if this request is valid, returns false and logs errors if it is not */
 	virtual bool ValidateAndLogErrors() const;
+
+protected:
+	/** Typed URL options set from code, merged on top of ExtraArgs */
+	FCommonSessionTravelOptions TravelOptions;
 };
 
 
@@ -235,7 +282,7 @@ private:
  * One subsystem is created for each game instance and can be accessed from blueprints or C++ code.
  * If a game-specific subclass exists, this base subsystem will not be created.
  */
-UCLASS()
+UCLASS(Config=Game)
 class COMMONUSER_API UCommonSessionSubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
@@ -267,6 +314,26 @@ public:
 	/** Starts a process to look for existing sessions or create a new one if no viable sessions are found */
 	UFUNCTION(BlueprintCallable, Category=Session)
 	virtual void QuickPlaySession(APlayerController* JoiningOrHostingPlayer, UCommonSession_HostSessionRequest* Request);
+
+	/** If true, quick play prepares hosting while the search runs and hosts if no joinable session is found within QuickPlayRaceDeadline */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	bool bRaceQuickPlayHost = false;
+
+	/** Seconds a racing quick play waits for a joinable session before it commits to hosting */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	float QuickPlayRaceDeadline = 3.0f;
+
+	/** If true, a racing quick play creates its session unadvertised up front and only advertises it once it commits to hosting */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	bool bPreCreateQuickPlayHostSession = false;
+
+	/** Number of search results quick play tries to join, closest first, before it hosts instead */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	int32 QuickPlayMaxJoinAttempts = 3;
+
+	/** If true, quick play re-queries each candidate before joining it and skips sessions that filled up since the search */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	bool bRefreshQuickPlayCandidates = false;
 	
 	/** #START @AccelByte Implementation : Starts a process to matchmaking with other player. */
 	/** @brief Start Session, must manually called after Map / Experience successfully loaded */
@@ -297,11 +364,113 @@ public:
 
 	UPROPERTY(BlueprintAssignable, Category=Session)
 	FOnMatchFoundDelegate OnMatchFoundDelegate;
+
+	/** Confirms ready consent for the match found last, does nothing if it was already confirmed */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	virtual bool ConfirmReadyConsent(APlayerController* ConsentingPlayer);
+
+	/** Changes the ready consent policy at runtime, e.g. before queueing in the background */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void SetReadyConsentPolicy(ECommonReadyConsentPolicy Policy) { ReadyConsentPolicy = Policy; }
+
+	UFUNCTION(BlueprintPure, Category=Session)
+	ECommonReadyConsentPolicy GetReadyConsentPolicy() const { return ReadyConsentPolicy; }
+
+	/** Seconds between the last ready consent request and the match being ready, 0 if none was recorded */
+	UFUNCTION(BlueprintPure, Category=Session)
+	float GetLastReadyConsentRoundTrip() const { return LastReadyConsentRoundTrip; }
+
+	/** Whether ready consent is confirmed by the subsystem instead of waiting on the game */
+	UPROPERTY(Config)
+	ECommonReadyConsentPolicy ReadyConsentPolicy = ECommonReadyConsentPolicy::Manual;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMatchmakingSessionChosenDelegate, const FString&, SessionId, const FString&, ConnectString);
+
+	/** Called when matchmaking picked the session the local player joins, before the join request is sent, so party members can follow */
+	UPROPERTY(BlueprintAssignable, Category=Session)
+	FOnMatchmakingSessionChosenDelegate OnMatchmakingSessionChosenDelegate;
+
+	/**
+	 * Joins the session another player (usually the party leader) was matched into, without waiting for our own matchmaking notification.
+	 * A matchmaking result for the same session that arrives afterwards is ignored.
+	 *
+	 * @param ConnectString Server address of the session, used to travel ahead of the join if bFastFollowTravelBeforeJoin is set
+	 */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	virtual void FastFollowSession(APlayerController* JoiningPlayer, const FString& SessionId, const FString& ConnectString);
+
+	/** If true, a fast follow with a connect string travels right away and the session join runs alongside the travel */
+	UPROPERTY(Config)
+	bool bFastFollowTravelBeforeJoin = false;
+
+	DECLARE_DELEGATE_OneParam(FOnMatchmakingPartyReady, bool /*bWasSuccessful*/);
+	DECLARE_DELEGATE_RetVal_TwoParams(bool, FEnsureMatchmakingPartyDelegate, ULocalPlayer* /*LocalPlayer*/, const FOnMatchmakingPartyReady& /*OnReady*/);
+
+	/**
+	 * Bound by the social toolkit when it creates the party on first use instead of on login.
+	 * Returns true if the party is being created and matchmaking has to wait for OnReady, false to start matchmaking right away.
+	 */
+	FEnsureMatchmakingPartyDelegate EnsureMatchmakingPartyDelegate;
+
+	/** Number of times a matchmaking request is submitted before its failure is reported, 1 disables retries */
+	UPROPERTY(Config)
+	int32 MatchmakingMaxAttempts = 1;
+
+	/** Seconds before the first retry, doubled for each further attempt */
+	UPROPERTY(Config)
+	float MatchmakingRetryBaseDelay = 2.0f;
+
+	/** Upper bound of the retry delay before jitter */
+	UPROPERTY(Config)
+	float MatchmakingRetryMaxDelay = 30.0f;
+
+	/** Random fraction the retry delay is spread by, 0.25 means +/- 25% */
+	UPROPERTY(Config)
+	float MatchmakingRetryJitter = 0.25f;
+
+	/** If true each retry relaxes the search through WidenMatchmakingSearchSettings */
+	UPROPERTY(Config)
+	bool bWidenMatchmakingOnRetry = false;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMatchmakingRetryDelegate, int32, NextAttempt, float, Delay);
+
+	/** Called when a failed matchmaking attempt is going to be re-submitted, the request only finishes after the last attempt */
+	UPROPERTY(BlueprintAssignable, Category=Session)
+	FOnMatchmakingRetryDelegate OnMatchmakingRetryDelegate;
+
+	/**
+	 * Returns the queue time below which the given fraction of recorded matches for the queue were found.
+	 * Percentile 0.5 is the typical wait. Returns false if no match has been recorded for the queue yet.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	bool GetEstimatedQueueTime(const FString& Queue, float& OutSeconds, float Percentile = 0.5f) const;
+
+	/** Seconds the running matchmaking request has been waiting, 0 if none is running */
+	UFUNCTION(BlueprintPure, Category=Session)
+	float GetMatchmakingElapsedTime() const;
+
+	/** Fraction of recorded matches for the queue that were found faster than the current wait */
+	UFUNCTION(BlueprintPure, Category=Session)
+	float GetMatchmakingWaitPercentile(const FString& Queue) const;
+
+	/** Weight kept by older queue time samples each time a new one is recorded, lower values adapt faster */
+	UPROPERTY(Config)
+	float MatchmakingQueueStatsDecay = 0.95f;
 	// #END
 
 	/** #START @AccelByte Implementation : attach extra argument to client travel URL*/
 	UPROPERTY(BlueprintReadWrite, Category=Session)
 	TMap<FString, FString> ClientExtraArgs;
+
+	/** Typed options attached to the next client travel URL, merged on top of ClientExtraArgs */
+	FCommonSessionTravelOptions ClientTravelOptions;
+
+	/**
+	 * Reads an option the client attached to its travel URL from the Options string a game mode receives in InitGame, PreLogin or Login.
+	 * Values are escaped on the client, use this instead of ParseOption to get ClientExtraArgs values back unchanged.
+	 */
+	UFUNCTION(BlueprintPure, Category=Session)
+	static FString GetClientTravelOption(const FString& Options, const FString& Key);
 	// #END
 	
 	/** Starts process to join an existing session, if successful this will connect to the specified server */
@@ -316,6 +485,173 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Session)
 	virtual void CleanUpSessions();
 
+	/**
+	 * Ends and destroys the game session, the returned future is fulfilled once the session is gone or the teardown gave up.
+	 * Calls made while a teardown is already running join it instead of issuing new requests.
+	 *
+	 * @param bFastLeave If true and the backend allows it, skip EndSession and destroy the session directly
+	 */
+	TFuture<bool> CleanUpSessionsAsync(bool bFastLeave);
+
+	/** If true, CleanUpSessions will skip EndSession when the session can be destroyed directly */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	bool bFastLeaveSessions = false;
+
+	/**
+	 * Session the local players are playing in, it alternates between two names as next sessions are swapped in.
+	 * Online sessions can not be renamed, so after a swap the engine is pointed at the active name instead: every map
+	 * load copies it into AGameSession::SessionName and the SessionName of each APlayerState in the world.
+	 */
+	FName GetActiveSessionName() const { return ActiveSessionName; }
+
+	/** Session name the next match is joined under while the active session is still running */
+	FName GetNextSessionName() const;
+
+	/** Joins a session as the next match, the active session is kept and no travel happens until SwapToNextSession */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	virtual void PreJoinNextSession(APlayerController* JoiningPlayer, UCommonSession_SearchResult* Request);
+
+	/** Starts matchmaking for the next match while the active session keeps running, the match found is pre-joined */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	virtual void MatchmakingNextSession(APlayerController* JoiningPlayer, UCommonSession_HostSessionRequest* HostRequest, UCommonSession_SearchSessionRequest*& OutMatchmakingSessionRequest);
+
+	/** Returns true if a next session has been joined and can be swapped in */
+	UFUNCTION(BlueprintPure, Category=Session)
+	bool IsNextSessionReady() const { return bNextSessionReady; }
+
+	/** Leaves the active session in the background and travels to the pre-joined next session, returns false if none is ready */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	bool SwapToNextSession();
+
+	/** Leaves the pre-joined next session without affecting the active one */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void LeaveNextSession();
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNextSessionReadyDelegate, bool, bWasSuccessful);
+
+	/** Called when joining the next session finished, on success the session can be swapped in */
+	UPROPERTY(BlueprintAssignable, Category=Session)
+	FOnNextSessionReadyDelegate OnNextSessionReadyDelegate;
+
+	/** Seconds to wait for each end/destroy step before retrying it */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	float TeardownStepTimeout = 10.0f;
+
+	/** Number of times a timed out or failed end/destroy step is retried before the teardown fails */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	int32 TeardownStepMaxRetries = 2;
+
+	/** Sets an advertised string on the hosted session, the change is sent with the next batched session update */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void SetHostSessionStringSetting(FName Key, const FString& Value);
+
+	/** Sets an advertised integer on the hosted session, the change is sent with the next batched session update */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void SetHostSessionIntSetting(FName Key, int32 Value);
+
+	/** Changes the number of public connections of the hosted session, the change is sent with the next batched session update */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void SetHostSessionMaxPlayers(int32 MaxPlayers);
+
+	/** Immediately sends any pending host session setting changes */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void FlushHostSessionSettings();
+
+	/** Seconds host setting changes are collected before one session update is sent, 0 sends every change immediately */
+	UPROPERTY(Config, BlueprintReadWrite, Category=Session)
+	float HostSettingsUpdateDelay = 1.0f;
+
+	/**
+	 * If true, a dedicated server keeps a roster of the players logged into its game mode and registers them with the active session.
+	 * The game mode should not register players itself when this is enabled.
+	 */
+	UPROPERTY(Config)
+	bool bServerPlayerRoster = false;
+
+	/** Seconds roster changes are collected before they are sent, 0 sends them on the next tick */
+	UPROPERTY(Config)
+	float ServerRosterFlushDelay = 0.0f;
+
+	/** Number of players on the dedicated server roster */
+	UFUNCTION(BlueprintPure, Category=Session)
+	int32 GetServerPlayerCount() const;
+
+	/** True if the AccelByte user is on the dedicated server roster */
+	UFUNCTION(BlueprintPure, Category=Session)
+	bool IsServerPlayerRegistered(const FString& AccelByteId) const;
+
+	/**
+	 * If true, a dedicated server drives its session on its own: it starts the session once ServerAutoStartPlayerCount players are in,
+	 * ends it when the match enters WaitingPostMatch, and destroys and recreates a played session that stayed empty for ServerIdleRecycleDelay.
+	 */
+	UPROPERTY(Config)
+	bool bServerSessionAutopilot = false;
+
+	/** Players that must be logged in before the autopilot starts the session */
+	UPROPERTY(Config)
+	int32 ServerAutoStartPlayerCount = 1;
+
+	/** Seconds a played session may stay empty before the autopilot recycles it, 0 disables recycling */
+	UPROPERTY(Config)
+	float ServerIdleRecycleDelay = 60.0f;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnServerSessionRecycledDelegate, bool, bWasSuccessful);
+
+	/** Called on a dedicated server once the autopilot recreated an idle session, a session recycled from an armed warm session template reports through OnServerWarmSessionReadyDelegate instead */
+	UPROPERTY(BlueprintAssignable, Category=Session)
+	FOnServerSessionRecycledDelegate OnServerSessionRecycledDelegate;
+
+	/**
+	 * Keeps a pre-registered session built from Template ready on a dedicated server, so a match can be placed on it without waiting for registration.
+	 * The session is armed again from the same template every time the previous one is destroyed.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	bool ArmServerWarmSession(UCommonSession_HostSessionRequest* Template);
+
+	/** Stops re-arming the warm session, the current session is left alone */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void DisarmServerWarmSession();
+
+	/**
+	 * Hands the ready warm session to a match: match specific values set with the SetHostSession functions are applied
+	 * and the session is started, or left to the autopilot to start once ServerAutoStartPlayerCount players are in.
+	 * Also done when the first player logs in. Returns false if no warm session is ready.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	bool ClaimServerWarmSession();
+
+	UFUNCTION(BlueprintPure, Category=Session)
+	bool IsServerWarmSessionReady() const { return bServerWarmSessionReady; }
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnServerWarmSessionReadyDelegate, bool, bWasSuccessful);
+
+	/** Called on a dedicated server once each time arming the warm session finished, including re-arming through a recycle */
+	UPROPERTY(BlueprintAssignable, Category=Session)
+	FOnServerWarmSessionReadyDelegate OnServerWarmSessionReadyDelegate;
+
+	/** Seconds to wait before arming the warm session again after a failed attempt */
+	UPROPERTY(Config)
+	float ServerWarmSessionRetryDelay = 5.0f;
+
+	/** Returns the catalog entry for a hostable map, or null if the map is not a known primary asset */
+	const FCommonSessionMapCatalogEntry* FindMapCatalogEntry(const FPrimaryAssetId& MapID) const;
+
+	/** Primary asset types indexed by the map catalog when it is built */
+	UPROPERTY(Config)
+	TArray<FPrimaryAssetType> MapCatalogAssetTypes = { FPrimaryAssetType(TEXT("Map")) };
+
+	/** Asset registry tags of map assets that are advertised on hosted sessions and used as matchmaking filters */
+	UPROPERTY(Config)
+	TArray<FName> MapCatalogMatchmakingTags;
+
+	/** If true, the server address of a session is resolved while it is being joined and travel connects to the resolved address */
+	UPROPERTY(Config)
+	bool bPreResolveConnectStrings = true;
+
+	/** Returns true if sessions owned by this AccelByte user are dropped from search results */
+	UFUNCTION(BlueprintPure, Category=Session)
+	bool IsSessionOwnerBlocked(const FString& AccelByteId) const { return BlockedAccelByteIds.Contains(AccelByteId); }
+
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSessionCreatedDelegate);
 
 	UPROPERTY(BlueprintAssignable, Category=Session)
@@ -334,6 +670,24 @@ protected:
 	/** Called when a quick play search finishes, can be overridden for game-specific behavior */
 	virtual void HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest);
 
+	/** Validates the host side of a quick play and starts its deadline, returns false if the request cannot race its search */
+	bool PrepareQuickPlayRace(APlayerController* Player, UCommonSession_HostSessionRequest* HostRequest, UCommonSession_SearchSessionRequest* SearchRequest);
+	/** Hosts the prepared quick play, advertising the session if it was pre-created */
+	void CommitQuickPlayRace();
+	/** Drops the prepared quick play, Then runs once any pre-created session is gone */
+	void DiscardQuickPlayRace(TFunction<void()>&& Then);
+	/** Stops the deadline and detaches the race from its search, the search result no longer decides anything */
+	void SettleQuickPlayRace();
+	void HandleQuickPlayRaceDeadline();
+	void HandleQuickPlayRaceSessionCreated(bool bWasSuccessful);
+
+	/** Joins the next ranked quick play candidate, or hosts once the candidates or attempts run out */
+	void TryNextQuickPlayCandidate();
+	/** Issues the join for a quick play candidate, only joins actually issued count against QuickPlayMaxJoinAttempts */
+	void JoinQuickPlayCandidate(const TStrongObjectPtr<UCommonSession_SearchResult>& Candidate);
+	/** Called when a quick play join finished, returns true if another candidate is being tried */
+	bool HandleQuickPlayJoinFinished(bool bWasSuccessful, bool bCanTryNext);
+
 	// #START @AccelByte Implementation HandleMatchmaking Finished
 	virtual void HandleMatchmakingFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest);
 	// #END
@@ -350,23 +704,40 @@ protected:
 	/** Called after traveling to the new hosted session map */
 	virtual void HandlePostLoadMap(UWorld* World);
 
+	/** Points the game session and player states of the world at ActiveSessionName, so engine session calls use the swapped in session */
+	void ApplyActiveSessionName(UWorld* World);
+	void HandleActorSpawnedWithSessionName(AActor* Actor);
+
 protected:
 	// Internal functions for initializing and handling results from the online systems
 
 	void BindOnlineDelegates();
 	void CreateOnlineSessionInternal(ULocalPlayer* LocalPlayer, UCommonSession_HostSessionRequest* Request);
 	void FindSessionsInternal(APlayerController* SearchingPlayer, const TSharedRef<FCommonOnlineSearchSettings>& InSearchSettings);
-	void JoinSessionInternal(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request);
+	void JoinSessionInternal(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request, FName SessionName);
 	void InternalTravelToSession(const FName SessionName);
+	/** Appends the pending client travel options to a connect string and travels to it */
+	void TravelToConnectString(APlayerController* PlayerController, FString URL);
+
+	/** Ends and destroys a named session, teardowns of different sessions run one after another */
+	TFuture<bool> TearDownSessionAsync(FName SessionName, bool bFastLeave);
+	void HandleNextSessionJoined(bool bWasSuccessful);
 
 #if COMMONUSER_OSSV1
 	void BindOnlineDelegatesOSSv1();
 	void CreateOnlineSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_HostSessionRequest* Request);
+	/** Builds the advertised settings of a host request */
+	TSharedRef<FCommonSession_OnlineSessionSettings> BuildHostSettingsOSSv1(const UCommonSession_HostSessionRequest* Request) const;
 	void FindSessionsInternalOSSv1(ULocalPlayer* LocalPlayer);
-	void JoinSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request);
+	void JoinSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request, FName SessionName);
 	TSharedRef<FCommonOnlineSearchSettings> CreateQuickPlaySearchSettingsOSSv1(UCommonSession_HostSessionRequest* Request, UCommonSession_SearchSessionRequest* QuickPlayRequest);
 	void CleanUpSessionsOSSv1();
 
+	/** Issues the next end/destroy request for the active teardown based on the current session state */
+	void AdvanceTeardownOSSv1();
+	/** Returns true if the session can be destroyed without ending it first */
+	virtual bool CanDestroySessionDirectly(const FNamedOnlineSession& Session) const;
+
 	void HandleSessionFailure(const FUniqueNetId& NetId, ESessionFailure::Type FailureType);
 	void OnStartSessionComplete(FName SessionName, bool bWasSuccessful);
 	void OnRegisterLocalPlayerComplete_CreateSession(const FUniqueNetId& PlayerId, EOnJoinSessionCompleteResult::Type Result);
@@ -380,18 +751,54 @@ protected:
 	void OnCancelMatchmakingComplete(FName SessionName, bool bWasSuccessful);
 	void OnMatchmakingTimeout(const FErrorInfo& Error);
 	void OnMatchFound(FString MatchId);
+
+	/** True if ReadyConsentPolicy allows confirming the pending ready consent without the game */
+	bool ShouldAutoConfirmReadyConsent(const ULocalPlayer* LocalPlayer) const;
+	/** Sends the ready consent for PendingReadyConsentMatchId */
+	bool SendReadyConsent(const ULocalPlayer* LocalPlayer);
+	/** Records the consent round trip once the match is ready */
+	void FinishReadyConsent(bool bMatchReady);
+
+	/** Submits the matchmaking ticket for one queue of the current request, returns false if it could not be submitted */
+	bool StartMatchmakingTicketOSSv1(const TSharedRef<FCommonOnlineSearchSettings>& Search, const FString& Queue);
+	/**
+	 * Fails over to the next alternate queue of the current request, returns false if none is left.
+	 * The AccelByte v1 session interface keeps one matchmaking search per party, so queues are searched one after another.
+	 */
+	bool StartNextMatchmakingQueue();
+	/** Fills the pending queues from the alternate game modes of a request */
+	void ResetMatchmakingQueues(const UCommonSession_HostSessionRequest* HostRequest);
+
+	/** Schedules the next attempt of the current matchmaking request, returns false if no attempts are left */
+	bool ScheduleMatchmakingRetry();
+	void RetryMatchmaking();
+	void ClearMatchmakingRetry();
+
+	/** Relaxes the search criteria of a retried matchmaking attempt, can be overridden for game-specific behavior */
+	virtual void WidenMatchmakingSearchSettings(FCommonOnlineSearchSettings& Search, int32 Attempt) const;
 	// #End
 	
 	void OnFindSessionsComplete(bool bWasSuccessful);
+	/** Returns true if the result is owned by a blocked player and should not be shown */
+	bool IsSearchResultBlocked(const FOnlineSessionSearchResult& Result) const;
+
+	/** Blocked list handlers that keep BlockedAccelByteIds in sync with the friends interface */
+	void HandleQueryBlockedPlayersComplete(const FUniqueNetId& UserId, bool bWasSuccessful, const FString& Error);
+	void HandleBlockedPlayerComplete(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UniqueId, const FString& ListName, const FString& Error);
+	void HandleUnblockedPlayerComplete(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UniqueId, const FString& ListName, const FString& Error);
+	/** Drops the blocked list once the user it belongs to logs out or another user logs in */
+	void HandleBlockedListOwnerLoginStatusChanged(int32 LocalUserNum, ELoginStatus::Type OldStatus, ELoginStatus::Type NewStatus, const FUniqueNetId& NewId);
+	/** Index of the local player whose blocked list filters search results, the first game player */
+	int32 GetBlockedListOwnerIndex() const;
 	void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
 	void OnRegisterJoiningLocalPlayerComplete(const FUniqueNetId& PlayerId, EOnJoinSessionCompleteResult::Type Result);
-	void FinishJoinSession(EOnJoinSessionCompleteResult::Type Result);
+	void FinishJoinSession(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
 
 #else
 	void BindOnlineDelegatesOSSv2();
 	void CreateOnlineSessionInternalOSSv2(ULocalPlayer* LocalPlayer, UCommonSession_HostSessionRequest* Request);
 	void FindSessionsInternalOSSv2(ULocalPlayer* LocalPlayer);
-	void JoinSessionInternalOSSv2(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request);
+	void JoinSessionInternalOSSv2(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request, FName SessionName);
 	TSharedRef<FCommonOnlineSearchSettings> CreateQuickPlaySearchSettingsOSSv2(UCommonSession_HostSessionRequest* HostRequest, UCommonSession_SearchSessionRequest* SearchRequest);
 	void CleanUpSessionsOSSv2();
 
@@ -399,8 +806,39 @@ protected:
 	UE::Online::FOnlineAccountIdHandle GetAccountId(APlayerController* PlayerController) const;
 	/** Get the lobby id for a given session name */
 	UE::Online::FOnlineLobbyIdHandle GetLobbyId(const FName SessionName) const;
+
+	/** Lobby event handlers that keep JoinedLobbies in sync */
+	void HandleLobbyJoined(const UE::Online::FLobbyJoined& LobbyJoined);
+	void HandleLobbyLeft(const UE::Online::FLobbyLeft& LobbyLeft);
+	void HandleLobbyUpdated(const TSharedRef<const UE::Online::FLobby>& Lobby);
 #endif // COMMONUSER_OSSV1
 
+	/** Starts the batching window for dirty host settings if it is not already running */
+	void QueueHostSettingsUpdate();
+
+	/** Dedicated server roster, players are added and removed as they log in and out of the game mode */
+	void HandleServerPostLogin(class AGameModeBase* GameMode, APlayerController* NewPlayer);
+	void HandleServerLogout(class AGameModeBase* GameMode, AController* Exiting);
+	/** Schedules the next roster flush if one is not already pending */
+	void QueueServerRosterFlush();
+	/** Sends the pending registrations, unregistrations and open connection count in one batch */
+	void FlushServerRoster();
+
+	/** Dedicated server autopilot, moves the active session along as players come and go and the match progresses */
+	void HandleServerMatchStateSet(FName MatchState);
+	void UpdateServerSessionAutopilot();
+	void HandleServerSessionIdle();
+	void HandleServerSessionRecreated(bool bWasSuccessful);
+
+	/** Creates the warm session from ServerWarmSessionTemplate */
+	void CreateServerWarmSession();
+	void HandleServerWarmSessionCreated(bool bWasSuccessful);
+
+	/** Arms the timeout for the current teardown step, returns false if the step ran out of retries */
+	bool BeginTeardownStep(ECommonSessionTeardownStep Step);
+	void HandleTeardownStepTimeout();
+	void FinishTeardown(bool bWasSuccessful);
+
 protected:
 	/** The travel URL that will be used after session operations are complete */
 	FString PendingTravelURL;
@@ -408,10 +846,117 @@ protected:
 	/** True if we want to cancel the session after it is created */
 	bool bWantToDestroyPendingSession = false;
 
+	/** Name of the session the local players are playing in */
+	FName ActiveSessionName = NAME_GameSession;
+
+	/** Base session name of the running matchmaking request, the next session name when matchmaking for the next match */
+	FName MatchmakingSessionName = NAME_GameSession;
+
+	/** True while the running matchmaking request is for the next match */
+	bool bMatchmakingNextSession = false;
+
+	bool bNextSessionJoining = false;
+	bool bNextSessionReady = false;
+
+	/** World whose replicated player states get ActiveSessionName as they spawn */
+	TWeakObjectPtr<UWorld> SessionNameWorld;
+	FDelegateHandle SessionNameActorSpawnedHandle;
+
+	/** Id of the session being fast followed, empty if none */
+	FString FastFollowSessionId;
+
+	/** True if the fast follow already traveled, the join completion then does not travel again */
+	bool bFastFollowTraveled = false;
+
 	/** Settings for the current search */
 	TSharedPtr<FCommonOnlineSearchSettings> SearchSettings;
 
 	/** Settings for the current host request */
 	TSharedPtr<FCommonSession_OnlineSessionSettings> HostSettings;
 
+	/** Map lookup shared by host requests, search settings and travel */
+	TSharedPtr<FCommonSessionMapCatalog> MapCatalog;
+
+	/** Server addresses resolved ahead of travel */
+	TSharedPtr<FCommonSessionConnectCache> ConnectCache;
+
+	/** Timer for the pending batched host settings update */
+	FTimerHandle HostSettingsUpdateTimerHandle;
+
+	/** Players logged into the dedicated server, keyed by AccelByte id */
+	TMap<FString, FUniqueNetIdRef> ServerRoster;
+
+	/** Roster changes not sent to the session yet */
+	TSet<FString> PendingServerRegistrations;
+	TMap<FString, FUniqueNetIdRef> PendingServerUnregistrations;
+
+	/** Timer for the pending roster flush */
+	FTimerHandle ServerRosterFlushTimerHandle;
+
+	/** Timer that recycles the active session once it stayed empty long enough */
+	FTimerHandle ServerIdleTimerHandle;
+
+	/** True while the autopilot destroys and recreates the active session */
+	bool bRecyclingServerSession = false;
+
+	/** Host request the warm session is built from, null if no warm session is kept */
+	UPROPERTY(Transient)
+	TObjectPtr<UCommonSession_HostSessionRequest> ServerWarmSessionTemplate;
+
+	/** Warm session state, it is either being created, ready to be claimed, or claimed by the running match */
+	bool bArmingServerWarmSession = false;
+	bool bServerWarmSessionReady = false;
+	double ServerWarmSessionReadyTime = 0.0;
+
+	/** Timer for the next warm session arming attempt */
+	FTimerHandle ServerWarmSessionTimerHandle;
+
+	/** State of the end/destroy pipeline, valid while a teardown is running */
+	TSharedPtr<FCommonSessionTeardown> ActiveTeardown;
+
+	/** Recorded queue times per matchmaking queue */
+	FCommonMatchmakingQueueStats MatchmakingQueueStats;
+
+	/** Time the running matchmaking request started queueing, 0 if none is running */
+	double MatchmakingStartTime = 0.0;
+
+	/** Match waiting for our ready consent, empty if none */
+	FString PendingReadyConsentMatchId;
+
+	/** Time ready consent was requested and sent, 0 if not yet */
+	double ReadyConsentRequestTime = 0.0;
+	double ReadyConsentSentTime = 0.0;
+
+	float LastReadyConsentRoundTrip = 0.0f;
+
+	/** Host side of the running quick play, valid while it races its search */
+	TSharedPtr<FCommonQuickPlayRace> QuickPlayRace;
+
+	/** Remaining join candidates of the running quick play */
+	TSharedPtr<FCommonQuickPlayJoin> QuickPlayJoin;
+
+	/** AccelByte ids of players blocked by the primary local user, owners in this set are skipped when search results are built */
+	TSet<FString> BlockedAccelByteIds;
+
+#if COMMONUSER_OSSV1
+	/** Matchmaking ticket of the queue currently searched for the request */
+	TSharedPtr<FCommonMatchmakingTicket> ActiveMatchmakingTicket;
+
+	/** Alternate queues of the current request that have not been submitted yet */
+	TArray<FString> PendingMatchmakingQueues;
+
+	FUniqueNetIdPtr MatchmakingUserId;
+
+	/** Original request of the running matchmaking, valid until its final attempt finishes */
+	TSharedPtr<FCommonMatchmakingRetry> MatchmakingRetry;
+#endif // COMMONUSER_OSSV1
+
+#if !COMMONUSER_OSSV1
+	/** Lobbies the local user is a member of, keyed by their local session name */
+	TMap<FName, TSharedRef<const UE::Online::FLobby>> JoinedLobbies;
+
+	/** Subscriptions to lobby events, unbound on deinitialize */
+	TArray<UE::Online::FOnlineEventDelegateHandle> LobbyEventHandles;
+#endif // !COMMONUSER_OSSV1
+
 };
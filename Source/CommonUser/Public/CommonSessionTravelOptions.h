@@ -0,0 +1,90 @@
+// Copyright (c) 2018 AccelByte, inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Option keys the session code itself reads or writes */
+namespace CommonSessionTravelOption
+{
+	COMMONUSER_API extern const FName Listen;
+	COMMONUSER_API extern const FName LanMatch;
+	COMMONUSER_API extern const FName NumBots;
+}
+
+/**
+ * Typed set of travel URL options (?Key=Value).
+ * Built once per request and written into a single pre-sized buffer with values escaped.
+ * String values are percent-escaped, so the receiving game mode must read them through FromGameModeOptions or GetGameModeOption
+ * instead of UGameplayStatics::ParseOption to get the original values back.
+ */
+struct COMMONUSER_API FCommonSessionTravelOptions
+{
+public:
+	/** Adds an option without a value, e.g. ?listen */
+	void SetFlag(FName Key);
+	void SetInt(FName Key, int32 Value);
+	void SetBool(FName Key, bool Value);
+	void SetString(FName Key, const FString& Value);
+
+	/** Copies every option of Other on top of this set, replacing options with the same key */
+	void Merge(const FCommonSessionTravelOptions& Other);
+
+	void Remove(FName Key);
+	void Reset();
+
+	bool Contains(FName Key) const;
+	bool IsEmpty() const { return Options.Num() == 0; }
+
+	/** Returns the value as an integer, string values are converted */
+	TOptional<int32> GetInt(FName Key) const;
+
+	/** Returns the value as a bool, flags are true and integers are true when non zero */
+	TOptional<bool> GetBool(FName Key) const;
+
+	/** Returns the value as it would be written in the URL, unescaped */
+	TOptional<FString> GetString(FName Key) const;
+
+	/** Appends all options to the end of URL */
+	void AppendTo(FString& URL) const;
+
+	/** Returns all options in URL form, starting with the first '?' */
+	FString ToString() const;
+
+	/** Parses the options part of a travel URL or the Options string a game mode receives, values are kept as strings */
+	static FCommonSessionTravelOptions Parse(const FString& OptionsString);
+
+	/** Server side entry point, parses the Options string passed to AGameModeBase::InitGame, PreLogin or Login */
+	static FCommonSessionTravelOptions FromGameModeOptions(const FString& Options) { return Parse(Options); }
+
+	/** Unescaped replacement for UGameplayStatics::ParseOption, returns an empty string if the option is not set */
+	static FString GetGameModeOption(const FString& Options, const FString& Key);
+
+private:
+	enum class EValueType : uint8
+	{
+		Flag,
+		Int,
+		Bool,
+		String
+	};
+
+	struct FOption
+	{
+		FName Key;
+		EValueType Type = EValueType::Flag;
+		int32 IntValue = 0;
+		FString StringValue;
+	};
+
+	FOption* FindOption(FName Key);
+	const FOption* FindOption(FName Key) const;
+	FOption& FindOrAddOption(FName Key);
+
+	static bool IsValidKey(FName Key);
+	static void AppendEscaped(FString& Out, const FString& Value);
+	static FString Unescape(const FString& Value);
+
+	/** Options in insertion order, sets are small so keys are compared linearly */
+	TArray<FOption, TInlineAllocator<8>> Options;
+};